@@ -20,6 +20,13 @@ void shift_register_function(byte binary_data) {
     digitalWrite(latch_pin, HIGH);
 }
 
+// only needed when rs & en are on the shift register too
+void shift_register_buffer_function(const byte *bytes, const size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        shift_register_function(bytes[i]);
+    }
+}
+
 #include <arduino_lcdpp.h> // this header file should only be included AFTER the shift register function declaration
 
 
@@ -34,6 +41,10 @@ void setup() {
 
     // with shift register (requires a custom shift register function)
     LCD_Setup mylcd(lcd_rs_pin, lcd_rw_pin, lcd_enable_pin, 4, false, false, shift_register_function, true);
+
+    // with shift register for control & data pins (requires a shift register function that takes a buffer, somewhere to collect the frames, and the register outputs rs & en are on)
+    static LCD_SRFrames lcd_frames;
+    LCD_Setup mylcd(true, false, shift_register_buffer_function, &lcd_frames, 4, 5, true);
 }
 
 void loop() {
@@ -3,269 +3,241 @@
 
 
 
-LCD_Setup::LCD_Setup(const uint8_t rs, const uint8_t rw, const uint8_t en, const uint8_t data_length, const bool has2DisplayLines, const bool has5x10Font, const uint8_t d7pin, const uint8_t d6pin, const uint8_t d5pin, const uint8_t d4pin, const uint8_t d3pin, const uint8_t d2pin, const uint8_t d1pin, const uint8_t d0pin) {
-    LCD_data_length = &data_length;
-    usingTwoDisplayLines = has2DisplayLines;
-    if (has2DisplayLines) { character_limit_per_line = 40; }
-
-    switch (data_length) {
-        case 8:
-            pin_arrays.DL8_pin_array[0] = d7pin;
-            pin_arrays.DL8_pin_array[1] = d6pin;
-            pin_arrays.DL8_pin_array[2] = d5pin;
-            pin_arrays.DL8_pin_array[3] = d4pin;
-            pin_arrays.DL8_pin_array[4] = d3pin;
-            pin_arrays.DL8_pin_array[5] = d2pin;
-            pin_arrays.DL8_pin_array[6] = d1pin;
-            pin_arrays.DL8_pin_array[7] = d0pin;
-
-            for (size_t i{ 0 }; i < 8; i++) {
-                pinMode(pin_arrays.DL8_pin_array[i], OUTPUT);
-            }
-            break;
-
-        default:
-            pin_arrays.DL4_pin_array[0] = d7pin;
-            pin_arrays.DL4_pin_array[1] = d6pin;
-            pin_arrays.DL4_pin_array[2] = d5pin;
-            pin_arrays.DL4_pin_array[3] = d4pin;
-
-            for (size_t i{ 0 }; i < 4; i++) {
-                pinMode(pin_arrays.DL4_pin_array[i], OUTPUT);
-            }
-    }
-
-    rs_pin = &rs;
-    rw_pin = &rw;
-    en_pin = &en;
-    pinMode(rs, OUTPUT);
-    pinMode(rw, OUTPUT);
-    pinMode(en, OUTPUT);
-
-    delayMicroseconds(45000); // delay of more than 40 milliseconds which allows the LCD power to rise to 2.7 volts, the minimum power required to initialize the LCD by instruction, as specified on pg45-46 of the Hitachi HD44780 datasheet. Since the Arduino doesn't meet the required power supply conditions (4.5 volts) to activate the internal reset circuit of the LCD automatically, this has to be done.
-
-    set_rs_and_rw(LOW, LOW);
-    byte displayLines_and_font;
-
-    // INITIALIZATION BY INSTRUCTION
-    switch (data_length) {
-        case 8:
-            // temporary function set (8 bit data length)
-            send_byte_to_LCD(funcset_DL8_MSB, LCD_cmd_enable_pin_duration);
-            delayMicroseconds(4500);
-
-            // temporary function set (8 bit data length)
-            send_byte_to_LCD(funcset_DL8_MSB, LCD_cmd_enable_pin_duration);
-            delayMicroseconds(150);
+// bit-reversed value of every byte, used to turn datasheet bit order into pin array order with one table load. The nibbles for 4-bit mode are its two halves
+constexpr byte reversed(const byte b) {
+    return ((b & B00000001) << 7) | ((b & B00000010) << 5) | ((b & B00000100) << 3) | ((b & B00001000) << 1) | ((b & B00010000) >> 1) | ((b & B00100000) >> 3) | ((b & B01000000) >> 5) | ((b & B10000000) >> 7);
+}
 
-            // temporary function set (8 bit data length)
-            send_byte_to_LCD(funcset_DL8_MSB, LCD_cmd_enable_pin_duration);
+#define reversed_4(b) reversed(b), reversed(b + 1), reversed(b + 2), reversed(b + 3)
+#define reversed_16(b) reversed_4(b), reversed_4(b + 4), reversed_4(b + 8), reversed_4(b + 12)
+#define reversed_64(b) reversed_16(b), reversed_16(b + 16), reversed_16(b + 32), reversed_16(b + 48)
 
+static const byte reversed_bytes[256] PROGMEM = {
+    reversed_64(0), reversed_64(64), reversed_64(128), reversed_64(192)
+};
 
-            displayLines_and_font = funcset_DL8_MSB;
-            if (has2DisplayLines) { displayLines_and_font |= B00010000; }
-            if (has5x10Font) { displayLines_and_font |= B00100000; }
+#undef reversed_4
+#undef reversed_16
+#undef reversed_64
 
-            send_byte_to_LCD(displayLines_and_font, LCD_cmd_enable_pin_duration);
+// data write, command, clear & home, 1st & 2nd function set, power rise
+const LCD_TimingProfile LCD_HD44780_timing{ 43, 37, 1520, 4500, 150, 45000 }; // 37 microseconds per character plus 4 for the address counter to update (pg 25 of the datasheet)
+const LCD_TimingProfile LCD_ST7066U_timing{ 41, 37, 1520, 4100, 100, 40000 };
+const LCD_TimingProfile LCD_KS0066_timing{ 47, 39, 1530, 39, 39, 30000 }; // doesn't need the HD44780's reset sequence, so its function sets take the usual command time
+const LCD_TimingProfile LCD_fast_OLED_timing{ 10, 10, 6200, 4500, 150, 45000 };
 
-            send_byte_to_LCD(clearLCD_DL8_MSB, LCD_cmd_enable_pin_duration);
 
-            send_byte_to_LCD(returnLCDHome_DL8_MSB, 1520);
 
-            send_byte_to_LCD(entryset_incr_shift0_DL8_MSB, LCD_cmd_enable_pin_duration);
+LCD_Setup::LCD_Setup(const uint8_t rs, const uint8_t rw, const uint8_t en, const uint8_t data_length, const bool has2DisplayLines, const bool has5x10Font, const uint8_t d7pin, const uint8_t d6pin, const uint8_t d5pin, const uint8_t d4pin, const uint8_t d3pin, const uint8_t d2pin, const uint8_t d1pin, const uint8_t d0pin)
+    : LCD_Setup(LCD_begin_later, rs, rw, en, data_length, has2DisplayLines, has5x10Font, d7pin, d6pin, d5pin, d4pin, d3pin, d2pin, d1pin, d0pin) {
+#ifndef LCD_manual_begin
+    begin();
+#endif
+}
 
-            send_byte_to_LCD(display1_cursor0_blink0_DL8_MSB, LCD_cmd_enable_pin_duration);
 
-            break;
+LCD_Setup::LCD_Setup(const LCD_BeginLater, const uint8_t rs, const uint8_t rw, const uint8_t en, const uint8_t data_length, const bool has2DisplayLines, const bool has5x10Font, const uint8_t d7pin, const uint8_t d6pin, const uint8_t d5pin, const uint8_t d4pin, const uint8_t d3pin, const uint8_t d2pin, const uint8_t d1pin, const uint8_t d0pin)
+    : rs_pin{ rs }, rw_pin{ rw }, en_pin{ en }, usingEightBitMode{ data_length == 8 }, usingTwoDisplayLines{ has2DisplayLines }, usingShiftRegister{ false }, SR_bit_order_is_MSB{ true }, usingBusyFlag{ false }, rs_is_high{ false }, isAlreadyOnLine2{ false }, usingLargeFont{ has5x10Font && !has2DisplayLines }, isBatchingSRFrames{ false }, wrapsAtVisibleColumns{ true }, isDecrementing{ false } {
+    if (has2DisplayLines) { character_limit_per_line = 40; }
 
-        default:
-            // temporary function set (8 bit data length)
-            send_byte_to_LCD(funcset_DL8_MSB, LCD_cmd_enable_pin_duration, 4);
-            delayMicroseconds(4500);
+    pin_arrays.DL8_pin_array[0] = d7pin;
+    pin_arrays.DL8_pin_array[1] = d6pin;
+    pin_arrays.DL8_pin_array[2] = d5pin;
+    pin_arrays.DL8_pin_array[3] = d4pin;
+    pin_arrays.DL8_pin_array[4] = d3pin;
+    pin_arrays.DL8_pin_array[5] = d2pin;
+    pin_arrays.DL8_pin_array[6] = d1pin;
+    pin_arrays.DL8_pin_array[7] = d0pin;
 
-            // temporary function set (8 bit data length)
-            send_byte_to_LCD(funcset_DL8_MSB, LCD_cmd_enable_pin_duration, 4);
-            delayMicroseconds(150);
+#ifdef LCD_port_registers
+    find_pin_ports(data_length == 8 ? 8 : 4);
+#endif
 
-            // temporary function set (8 bit data length)
-            send_byte_to_LCD(funcset_DL8_MSB, LCD_cmd_enable_pin_duration, 4);
+    select_encoder();
+}
 
-            // temporary function set (4 bit data length)
-            send_byte_to_LCD(funcset_DL4_MSB, LCD_cmd_enable_pin_duration, 4);
 
+LCD_Setup::LCD_Setup(const uint8_t rs, const uint8_t rw, const uint8_t en, const uint8_t data_length, const bool has2DisplayLines, const bool has5x10Font, void (*SR_func)(byte), const bool SR_is_MSB)
+    : LCD_Setup(LCD_begin_later, rs, rw, en, data_length, has2DisplayLines, has5x10Font, SR_func, SR_is_MSB) {
+#ifndef LCD_manual_begin
+    begin();
+#endif
+}
 
-            displayLines_and_font = B00000000;
-            if (has2DisplayLines) { displayLines_and_font |= B00000001; }
-            if (has5x10Font) { displayLines_and_font |= B00000010; }
 
-            send_nibbles_to_LCD(B00000100, displayLines_and_font, LCD_cmd_enable_pin_duration);
+LCD_Setup::LCD_Setup(const LCD_BeginLater, const uint8_t rs, const uint8_t rw, const uint8_t en, const uint8_t data_length, const bool has2DisplayLines, const bool has5x10Font, void (*SR_func)(byte), const bool SR_is_MSB)
+    : rs_pin{ rs }, rw_pin{ rw }, en_pin{ en }, usingEightBitMode{ data_length == 8 }, usingTwoDisplayLines{ has2DisplayLines }, usingShiftRegister{ true }, SR_bit_order_is_MSB{ SR_is_MSB }, usingBusyFlag{ false }, rs_is_high{ false }, isAlreadyOnLine2{ false }, usingLargeFont{ has5x10Font && !has2DisplayLines }, isBatchingSRFrames{ false }, wrapsAtVisibleColumns{ true }, isDecrementing{ false } {
+    if (has2DisplayLines) { character_limit_per_line = 40; }
 
-            send_nibbles_to_LCD(B00000000, clearLCD_DL4_MSB, LCD_cmd_enable_pin_duration);
+    SR_func_ptr = SR_func;
 
-            send_nibbles_to_LCD(B00000000, returnLCDHome_DL4_MSB, 1520);
+#ifdef LCD_port_registers
+    find_pin_ports(0);
+#endif
 
-            send_nibbles_to_LCD(B00000000, entryset_incr_shift0_DL4_MSB, LCD_cmd_enable_pin_duration);
+    select_encoder();
+}
 
-            send_nibbles_to_LCD(B00000000, display1_cursor0_blink0_DL4_MSB, LCD_cmd_enable_pin_duration);
-    }
 
-    delayMicroseconds(100);
+LCD_Setup::LCD_Setup(const bool has2DisplayLines, const bool has5x10Font, void (*SR_buffer_func)(const byte *bytes, const size_t count), LCD_SRFrames *SR_frame_buffer, const uint8_t SR_rs_bit, const uint8_t SR_en_bit, const bool SR_is_MSB)
+    : LCD_Setup(LCD_begin_later, has2DisplayLines, has5x10Font, SR_buffer_func, SR_frame_buffer, SR_rs_bit, SR_en_bit, SR_is_MSB) {
+#ifndef LCD_manual_begin
+    begin();
+#endif
 }
 
 
-LCD_Setup::LCD_Setup(const uint8_t rs, const uint8_t rw, const uint8_t en, const uint8_t data_length, const bool has2DisplayLines, const bool has5x10Font, void (*SR_func)(byte), const bool SR_is_MSB) {
-    LCD_data_length = &data_length;
-    usingTwoDisplayLines = has2DisplayLines;
+LCD_Setup::LCD_Setup(const LCD_BeginLater, const bool has2DisplayLines, const bool has5x10Font, void (*SR_buffer_func)(const byte *bytes, const size_t count), LCD_SRFrames *SR_frame_buffer, const uint8_t SR_rs_bit, const uint8_t SR_en_bit, const bool SR_is_MSB)
+    : rs_pin{ 0 }, rw_pin{ 0 }, en_pin{ 0 }, usingEightBitMode{ false }, usingTwoDisplayLines{ has2DisplayLines }, usingShiftRegister{ true }, SR_bit_order_is_MSB{ SR_is_MSB }, usingBusyFlag{ false }, rs_is_high{ false }, isAlreadyOnLine2{ false }, usingLargeFont{ has5x10Font && !has2DisplayLines }, isBatchingSRFrames{ false }, wrapsAtVisibleColumns{ true }, isDecrementing{ false } {
     if (has2DisplayLines) { character_limit_per_line = 40; }
 
-    usingShiftRegister = true;
-    SR_bit_order_is_MSB = &SR_is_MSB;
-    SR_func_ptr = SR_func;
-
-    rs_pin = &rs;
-    rw_pin = &rw;
-    en_pin = &en;
-    pinMode(rs, OUTPUT);
-    pinMode(rw, OUTPUT);
-    pinMode(en, OUTPUT);
-
-    delayMicroseconds(45000); // delay of more than 40 milliseconds which allows the LCD power to rise to 2.7 volts, the minimum power required to initialize the LCD by instruction, as specified on pg45-46 of the Hitachi HD44780 datasheet. Since the Arduino doesn't meet the required power supply conditions (4.5 volts) to activate the internal reset circuit of the LCD automatically, this has to be done.
-
-    set_rs_and_rw(LOW, LOW);
-    byte displayLines_and_font;
-
-    // INITIALIZATION BY INSTRUCTION
-    switch (data_length) {
-        case 8:
-            displayLines_and_font = B00000000;
-            SR_is_MSB ? displayLines_and_font |= B00001100 : displayLines_and_font |= B00110000;
+    SR_buffer_func_ptr = SR_buffer_func;
+    SR_frames = SR_frame_buffer;
+    SR_frames->count = 0;
+    SR_rs_bit_mask = 1 << SR_rs_bit;
+    SR_en_bit_mask = 1 << SR_en_bit;
 
-            if (has2DisplayLines) {
-                SR_is_MSB ? displayLines_and_font |= B00010000 : displayLines_and_font |= B00001000;
-            }
-            if (has5x10Font) {
-                SR_is_MSB ? displayLines_and_font |= B00100000 : displayLines_and_font |= B00000100;
-            }
+    select_encoder();
+}
 
-            if (SR_is_MSB) {
-                SR_func_ptr(funcset_DL8_MSB);
-                toggle_enable_pin(37);
-                delayMicroseconds(4500);
 
-                SR_func_ptr(funcset_DL8_MSB);
-                toggle_enable_pin(37);
-                delayMicroseconds(150);
+LCD_Setup::LCD_Setup(const uint8_t I2C_backpack_address, const bool has2DisplayLines, const bool has5x10Font, void (*I2C_func)(const uint8_t address, const byte *bytes, const size_t count), LCD_SRFrames *SR_frame_buffer)
+    : rs_pin{ 0 }, rw_pin{ 0 }, en_pin{ 0 }, usingEightBitMode{ false }, usingTwoDisplayLines{ has2DisplayLines }, usingShiftRegister{ true }, SR_bit_order_is_MSB{ false }, usingBusyFlag{ false }, rs_is_high{ false }, isAlreadyOnLine2{ false }, usingLargeFont{ has5x10Font && !has2DisplayLines }, isBatchingSRFrames{ false }, wrapsAtVisibleColumns{ true }, isDecrementing{ false } {
+    if (has2DisplayLines) { character_limit_per_line = 40; }
 
-                SR_func_ptr(funcset_DL8_MSB);
-                toggle_enable_pin(37);
+    // the backpack's PCF8574 is wired like a shift register with LSB bit order: P0 = rs, P1 = rw, P2 = en, P3 = backlight, P4 -> P7 = db4 -> db7
+    I2C_func_ptr = I2C_func;
+    I2C_address = I2C_backpack_address;
+    SR_frames = SR_frame_buffer;
+    SR_frames->count = 0;
+    SR_rs_bit_mask = B00000001;
+    SR_en_bit_mask = B00000100;
+    SR_backlight_bit_mask = B00001000;
+    SR_control_bits = SR_backlight_bit_mask;
 
-                SR_func_ptr(displayLines_and_font);
-                toggle_enable_pin(37);
+    select_encoder();
 
-                SR_func_ptr(clearLCD_DL8_MSB);
-                toggle_enable_pin(37);
+    // Wire only works once the sketch has started (it needs interrupts), so 'begin' is always left to the sketch
+}
 
-                SR_func_ptr(returnLCDHome_DL8_MSB);
-                toggle_enable_pin(1520);
 
-                SR_func_ptr(entryset_incr_shift0_DL8_MSB);
-                toggle_enable_pin(37);
+void LCD_Setup::useTimingProfile(const LCD_TimingProfile *profile) {
+    timing = profile;
+}
 
-                SR_func_ptr(display1_cursor0_blink0_DL8_MSB);
-                toggle_enable_pin(37);
-            }
-            else {
-                SR_func_ptr(funcset_DL8_LSB);
-                toggle_enable_pin(37);
-                delayMicroseconds(4500);
 
-                SR_func_ptr(funcset_DL8_LSB);
-                toggle_enable_pin(37);
-                delayMicroseconds(150);
+void LCD_Setup::begin(const LCD_PowerOn power_on) {
+    // the rs, rw & en pins are on the shift register (or I2C backpack) when frames are sent
+    if (!sends_SR_frames()) {
+        pinMode(rs_pin, OUTPUT);
+        pinMode(rw_pin, OUTPUT);
+        pinMode(en_pin, OUTPUT);
+    }
 
-                SR_func_ptr(funcset_DL8_LSB);
-                toggle_enable_pin(37);
+    if (!usingShiftRegister) {
+        for (size_t i{ 0 }; i < (usingEightBitMode ? 8 : 4); i++) {
+            pinMode(pin_arrays.DL8_pin_array[i], OUTPUT);
+        }
+    }
 
-                SR_func_ptr(displayLines_and_font);
-                toggle_enable_pin(37);
+    current_cursor_position = 1;
+    isAlreadyOnLine2 = false;
+    display_shift = 0;
+    page_start = 0;
 
-                SR_func_ptr(clearLCD_DL8_LSB);
-                toggle_enable_pin(37);
+    // The LCD power has to rise to 2.7 volts, the minimum required to initialize it by instruction, which takes more than 40 milliseconds (pg 45-46 of the Hitachi HD44780 datasheet).
+    // Since the Arduino doesn't meet the power supply conditions (4.5 volts) that activate the LCD's internal reset circuit, the initialization has to be done by instruction
+    const unsigned long power_rise_time{ timing->power_rise };
+    unsigned long power_rise_wait{ power_rise_time };
 
-                SR_func_ptr(returnLCDHome_DL8_LSB);
-                toggle_enable_pin(1520);
+    if (power_on == LCD_power_is_stable) {
+        power_rise_wait = 0;
+    }
+    else if (power_on == LCD_wait_since_boot) {
+        // the board and LCD are assumed to have been powered on together
+        const unsigned long time_since_boot{ millis() < power_rise_time / 1000 ? micros() : power_rise_time };
+        power_rise_wait = time_since_boot < power_rise_time ? power_rise_time - time_since_boot : 0;
+    }
 
-                SR_func_ptr(entryset_incr_shift0_DL8_LSB);
-                toggle_enable_pin(37);
+    if (transmit_queue != nullptr) {
+        // the wait becomes the execution time of a transaction that's already been sent
+        transmit_queue->last_transfer_time = micros();
+        transmit_queue->current_execution_time = power_rise_wait;
+    }
+    else {
+        // delayMicroseconds is only accurate up to 16383 microseconds, and 'delay' doesn't work yet when this is called from a global constructor
+        LCD_count_stat(blocked_microseconds, power_rise_wait);
 
-                SR_func_ptr(display1_cursor0_blink0_DL8_LSB);
-                toggle_enable_pin(37);
-            }
+        for (; power_rise_wait > 15000; power_rise_wait -= 15000) { delayMicroseconds(15000); }
+        delayMicroseconds(power_rise_wait);
+    }
 
-            break;
+    // the busy flag can't be checked until the final function set has been sent
+    const bool busy_flag_setting{ usingBusyFlag };
+    usingBusyFlag = false;
 
-        default:
-            displayLines_and_font = B00000000;
-            if (has2DisplayLines) {
-                SR_is_MSB ? displayLines_and_font |= B00000001 : displayLines_and_font |= B10000000;
-            }
-            if (has5x10Font) {
-                SR_is_MSB ? displayLines_and_font |= B00000010 : displayLines_and_font |= B01000000;
-            }
+    set_rs_and_rw(LOW, LOW);
 
-            if (SR_is_MSB) {
-                SR_func_ptr(funcset_DL8_MSB);
-                toggle_enable_pin(37);
-                delayMicroseconds(4500);
+    // INITIALIZATION BY INSTRUCTION
+    // the LCD starts out in 8-bit mode, so in 4-bit mode only the upper nibble of these function sets is sent
+    send_to_LCD(functionSet_DL8, timing->first_function_set, true);
+    send_to_LCD(functionSet_DL8, timing->second_function_set, true);
+    send_to_LCD(functionSet_DL8, timing->command, true);
 
-                SR_func_ptr(funcset_DL8_MSB);
-                toggle_enable_pin(37);
-                delayMicroseconds(150);
+    if (!usingEightBitMode) {
+        send_to_LCD(functionSet_DL4, timing->command, true);
+    }
 
-                SR_func_ptr(funcset_DL8_MSB);
-                toggle_enable_pin(37);
+    usingBusyFlag = busy_flag_setting;
 
-                // temporary function set (4 bit data length)
-                SR_func_ptr(funcset_DL4_MSB);
-                toggle_enable_pin(37);
+    byte displayLines_and_font{ (byte)(usingEightBitMode ? functionSet_DL8 : functionSet_DL4) };
+    if (usingTwoDisplayLines) { displayLines_and_font |= B00001000; }
+    if (usingLargeFont) { displayLines_and_font |= B00000100; }
 
-                send_nibbles_to_SR(B00000100, displayLines_and_font);
+    send_to_LCD(displayLines_and_font);
+    send_to_LCD(clearLCD, timing->clear_and_home);
+    send_to_LCD(returnLCDHome, timing->clear_and_home);
+    send_to_LCD(entrySet_incr_shift0);
+    send_to_LCD(display1_cursor0_blink0);
 
-                send_nibbles_to_SR(B00000000, clearLCD_DL4_MSB);
+    isDecrementing = false;
+}
 
-                send_nibbles_to_SR(B00000000, returnLCDHome_DL4_MSB, 1520);
 
-                send_nibbles_to_SR(B00000000, entryset_incr_shift0_DL4_MSB);
+void LCD_Setup::beginPage(const bool clearPage) {
+    const uint8_t page_width{ screen_width() };
 
-                send_nibbles_to_SR(B00000000, display1_cursor0_blink0_DL4_MSB);
-            }
-            else {
-                SR_func_ptr(funcset_DL8_LSB);
-                toggle_enable_pin(37);
-                delayMicroseconds(4500);
+    // the 2 pages sit side by side in each line, from blocks 1 & 'page_width' + 1. If they don't both fit, the page on the screen is drawn on
+    page_start = display_shift == 0 && page_width * 2 <= character_limit_per_line ? page_width : 0;
 
-                SR_func_ptr(funcset_DL8_LSB);
-                toggle_enable_pin(37);
-                delayMicroseconds(150);
+    if (clearPage) {
+        for (uint8_t line{ 1 }; line <= (usingTwoDisplayLines ? 2 : 1); line++) {
+            uint8_t display_line{ line };
+            uint8_t block_number{ 1 };
 
-                SR_func_ptr(funcset_DL8_LSB);
-                toggle_enable_pin(37);
+            moveCursorPosition(display_line, block_number);
+            set_rs_and_rw(HIGH, LOW);
+            start_SR_batch();
 
-                // temporary function set (4 bit data length)
-                SR_func_ptr(funcset_DL4_LSB);
-                toggle_enable_pin(37);
+            for (uint8_t i{ 0 }; i < page_width; i++) { write_character(' '); }
 
-                send_nibbles_to_SR(B00000100, displayLines_and_font);
+            end_SR_batch();
+        }
+    }
 
-                send_nibbles_to_SR(B00000000, clearLCD_DL4_LSB);
+    uint8_t display_line{ 1 };
+    uint8_t block_number{ 1 };
+    moveCursorPosition(display_line, block_number);
+}
 
-                send_nibbles_to_SR(B00000000, returnLCDHome_DL4_LSB, 1520);
 
-                send_nibbles_to_SR(B00000000, entryset_incr_shift0_DL4_LSB);
+void LCD_Setup::flipPage() {
+    // the framebuffer's changes have to be on the LCD before the page is shown
+    if (framebuffer != nullptr) { flush(); }
 
-                send_nibbles_to_SR(B00000000, display1_cursor0_blink0_DL4_LSB);
-            }
-    }
+    // a shift takes 37 microseconds, so the screen goes past the in-between positions far quicker than the liquid crystal can show them
+    uint8_t num_of_moves{ (uint8_t)((page_start + character_limit_per_line - display_shift) % character_limit_per_line) };
+    moveDisplay(num_of_moves, true);
 }
 
 
@@ -290,548 +262,1414 @@ void LCD_Setup::cursorOFF() {
 
 
 void LCD_Setup::resetPositions() {
-    set_rs_and_rw(LOW, LOW);
-    const uint8_t data_length{ (*LCD_data_length) };
-    const bool SR_is_MSB{ (*SR_bit_order_is_MSB) };
-
-    if (usingShiftRegister) {
-        switch (data_length) {
-            case 8:
-                SR_is_MSB ? SR_func_ptr(B01000000) : SR_func_ptr(B00000010);
-                break;
+    current_cursor_position = 1;
+    isAlreadyOnLine2 = false;
+    display_shift = 0;
+    page_start = 0;
 
-            default:
-                SR_is_MSB ? send_nibbles_to_SR(B00000000, B00000100) : send_nibbles_to_SR(B00000000, B00100000);
-        }
-    }
-    else {
-        delayMicroseconds(100);
-
-        switch (data_length) {
-            case 8:
-                send_byte_to_LCD(B01000000, 1520);
-                break;
+    if (framebuffer != nullptr) { framebuffer->LCD_cursor_index = 0; }
 
-            default:
-                send_nibbles_to_LCD(B00000000, B00000100, 1520);
-        }
-    }
+    set_rs_and_rw(LOW, LOW);
+    send_to_LCD(returnLCDHome, timing->clear_and_home);
 }
 
 
 void LCD_Setup::moveCursor(uint8_t display_line, uint8_t block_number) {
+    LCD_start_call_timer();
+
     moveCursorPosition(display_line, block_number);
+
+    LCD_stop_call_timer(max_moveCursor_latency);
 }
 
 
 void LCD_Setup::clearDisplay() {
-            set_rs_and_rw(LOW, LOW);
-            const uint8_t data_length{ (*LCD_data_length) };
-            const bool SR_is_MSB{ (*SR_bit_order_is_MSB) };
-
-            if (usingShiftRegister) {
-                switch (data_length) {
-                    case 8:
-                        SR_is_MSB ? SR_func_ptr(B10000000) : SR_func_ptr(B00000001);
-                        break;
-
-                    default:
-                        SR_is_MSB ? send_nibbles_to_SR(B00000000, B00001000) : send_nibbles_to_SR(B00000000, B00010000);
-                }
-            }
-            else {
-                delayMicroseconds(100);
-
-                switch (data_length) {
-                    case 8:
-                        send_byte_to_LCD(B10000000, LCD_cmd_enable_pin_duration);
-                        break;
-
-                    default:
-                        send_nibbles_to_LCD(B00000000, B00001000, LCD_cmd_enable_pin_duration);
-                }
-            }
-        }
+    LCD_start_call_timer();
 
+    isAlreadyOnLine2 = false;
 
+    // only the blocks that weren't blank already will be sent on the next flush. The display isn't shifted back, so blocks are counted from the page that's shown
+    if (framebuffer != nullptr) {
+        memset(framebuffer->characters, ' ', LCD_DDRAM_size);
 
+        page_start = display_shift;
+        current_cursor_position = page_block(1);
 
+        LCD_stop_call_timer(max_clearDisplay_latency);
+        return;
+    }
 
+    current_cursor_position = 1;
+    display_shift = 0;
+    page_start = 0;
+    isDecrementing = false; // clearing the display also sets the entry mode back to increment
 
-/*  BITWISE MANIPULATION  */
+    set_rs_and_rw(LOW, LOW);
+    send_to_LCD(clearLCD, timing->clear_and_home);
 
-void LCD_Setup::toggle_enable_pin(const unsigned int delay) {
-    digitalWrite((*en_pin), HIGH);
-    delayMicroseconds(delay);
-    digitalWrite((*en_pin), LOW);
+    LCD_stop_call_timer(max_clearDisplay_latency);
 }
 
 
+void LCD_Setup::useFramebuffer(LCD_Framebuffer *new_framebuffer) {
+    // anything still waiting in the previous framebuffer is written out first
+    flush();
+    framebuffer = nullptr;
 
-void LCD_Setup::set_rs_and_rw(const unsigned int rs_state, const unsigned int rw_state) {
-    digitalWrite((*rs_pin), rs_state);
-    digitalWrite((*rw_pin), rw_state);
-}
-
+    if (new_framebuffer != nullptr) {
+        // the LCD and the framebuffer both start out blank so that they match
+        clearDisplay();
 
+        memset(new_framebuffer->characters, ' ', LCD_DDRAM_size);
+        memset(new_framebuffer->sent_characters, ' ', LCD_DDRAM_size);
+        new_framebuffer->LCD_cursor_index = 0;
 
-void LCD_Setup::send_byte_to_LCD(byte byte_to_send, const uint_fast16_t enable_timing, const uint8_t pin_array_size) {
-    for (size_t i{ 0 }; i < pin_array_size; i++) {
-        digitalWrite(pin_arrays.DL8_pin_array[i], (byte_to_send & B00000001));
-        byte_to_send >>= 1;
+        framebuffer = new_framebuffer;
     }
-
-    toggle_enable_pin(enable_timing);
 }
 
 
+void LCD_Setup::flush() {
+    if (framebuffer == nullptr) { return; }
 
-void LCD_Setup::send_nibbles_to_LCD(const byte nibble1, const byte nibble2, const uint_fast16_t enable_timing) {
-    byte current_nibble{ nibble1 };
+    set_rs_and_rw(HIGH, LOW);
+    start_SR_batch();
 
-    for (size_t i{ 0 }; i < 2; i++) {
-        for (size_t j{ 0 }; j < 4; j++) {
-            digitalWrite(pin_arrays.DL4_pin_array[j], (current_nibble & B00000001));
-            current_nibble >>= 1;
+    for (uint8_t i{ 0 }; i < LCD_DDRAM_size; i++) {
+        if (framebuffer->characters[i] == framebuffer->sent_characters[i]) { continue; }
+
+        // the address counter increments after every character, so a run of changed blocks only needs its first address to be set
+        if (i != framebuffer->LCD_cursor_index) {
+            set_rs_and_rw(LOW, LOW);
+            send_to_LCD(setDDRAMAddress | framebuffer_index_to_DDRAM_address(i));
+            set_rs_and_rw(HIGH, LOW);
         }
 
-        current_nibble = nibble2;
-        toggle_enable_pin(enable_timing);
+        send_character_to_LCD(framebuffer->characters[i]);
+        framebuffer->sent_characters[i] = framebuffer->characters[i];
+        framebuffer->LCD_cursor_index = i + 1;
     }
-}
 
+    // puts the LCD's cursor where the next character would be written
+    const uint8_t logical_cursor_index{ cursor_index() };
 
+    if (logical_cursor_index != framebuffer->LCD_cursor_index && logical_cursor_index < LCD_DDRAM_size) {
+        set_rs_and_rw(LOW, LOW);
+        send_to_LCD(setDDRAMAddress | framebuffer_index_to_DDRAM_address(logical_cursor_index));
+        framebuffer->LCD_cursor_index = logical_cursor_index;
+    }
 
-void LCD_Setup::send_nibbles_to_SR(const byte nibble1, const byte nibble2, const uint_fast16_t enable_timing) {
-    SR_func_ptr(nibble1);
-    toggle_enable_pin(enable_timing);
-    SR_func_ptr(nibble2);
-    toggle_enable_pin(enable_timing);
+    end_SR_batch();
 }
 
 
+void LCD_Setup::useTransmitQueue(LCD_TransmitQueue *new_transmit_queue) {
+    // lets the previous queue finish before the pins are driven directly again
+    if (transmit_queue != nullptr) {
+        while (transmit_queue->tail != transmit_queue->head) { service(); }
+        delayMicroseconds(transmit_queue->current_execution_time);
+        LCD_count_stat(blocked_microseconds, transmit_queue->current_execution_time);
+    }
 
-void LCD_Setup::translate_and_send_to_LCD(byte decimal_representation) {
-    byte byte_to_send{ decimal_representation }, nibble1{ B00000000 }, nibble2{ B00000000 }, *current_nibble{ &nibble2 }, byte_to_OR_with;
-    bool is_a_hit{ false };
+    transmit_queue = nullptr;
 
-    delayMicroseconds(1000);
+    if (new_transmit_queue != nullptr) {
+        new_transmit_queue->head = 0;
+        new_transmit_queue->tail = 0;
+        new_transmit_queue->high_water_mark = 0;
+        new_transmit_queue->overflow_count = 0;
+        new_transmit_queue->last_transfer_time = micros();
+        new_transmit_queue->current_execution_time = 0;
 
-    if (usingShiftRegister) {
-        const bool SR_is_MSB{ (*SR_bit_order_is_MSB) };
+        transmit_queue = new_transmit_queue;
+    }
+}
 
-        switch (data_length) {
-            case 8:
-                break;
 
-            default:
-                for (size_t i{ 0 }; i < 2; i++) {
-                    SR_is_MSB ? byte_to_OR_with = B00001000 : byte_to_OR_with = B00010000;
+void LCD_Setup::service() {
+    LCD_TransmitQueue *queue{ transmit_queue };
 
-                    for (size_t j{ 0 }; j < 4; j++) {
-                        is_a_hit = B00000001 == (decimal_representation & B00000001);
-                        decimal_representation >>= 1;
+    // 'service' may be called from both a timer interrupt and the sketch (e.g. while waiting for room in the queue). Displays on a bus share one lock since they share the pins
+    volatile bool &isLocked{ bus_lock != nullptr ? *bus_lock : isServicingQueue };
 
-                        is_a_hit ? (*current_nibble) |= byte_to_OR_with : (*current_nibble) |= B00000000;
-                        SR_is_MSB ? byte_to_OR_with >>= 1 : byte_to_OR_with <<= 1;
-                    }
+    if (queue == nullptr || isLocked) { return; }
+    isLocked = true;
 
-                    current_nibble = &nibble1;
-                }
+    if (queue->tail != queue->head && micros() - queue->last_transfer_time >= queue->current_execution_time) {
+        const uint8_t tail{ queue->tail };
 
-                send_nibbles_to_SR(nibble1, nibble2, 3000);
+        write_rs_and_rw(queue->transactions[tail].is_data ? HIGH : LOW, LOW);
+        if (queue->transactions[tail].is_function_set_nibble) {
+            send_function_set_nibble(queue->transactions[tail].value, 0);
         }
+        else {
+            (this->*encode_and_send_to_LCD)(queue->transactions[tail].value, 0);
+        }
+
+        queue->last_transfer_time = micros();
+        queue->current_execution_time = queue->transactions[tail].execution_time;
+        queue->tail = (tail + 1) % LCD_transmit_queue_size;
     }
-    else {
-        switch (data_length) {
-            case 8:
-                byte_to_send = B00000000;
-                byte_to_OR_with = B00000001;
 
-                for (size_t i{ 0 }; i < 8; i++) {
-                    is_a_hit = B00000001 == (decimal_representation & B00000001);
-                    decimal_representation >>= 1;
+    isLocked = false;
+}
+
 
-                    is_a_hit ? byte_to_send |= byte_to_OR_with : byte_to_send |= B00000000;
-                    byte_to_send <<= 1;
-                }
+bool LCD_Setup::isQueueEmpty() {
+    return transmit_queue == nullptr || transmit_queue->tail == transmit_queue->head;
+}
 
-                send_byte_to_LCD(byte_to_send); 
 
-                break;
 
-            default:
-                for (size_t i{ 0 }; i < 2; i++) {
-                    byte_to_OR_with = B00001000;
+void LCD_Setup::createCustomCharacter(const uint8_t slot, const byte *bitmap) {
+    const uint8_t number_of_slots{ (uint8_t)(usingLargeFont ? 4 : 8) };
+    const uint8_t number_of_rows{ (uint8_t)(usingLargeFont ? 11 : 8) };
+    const uint8_t slot_size{ (uint8_t)(usingLargeFont ? 16 : 8) };
 
-                    for (size_t j{ 0 }; j < 4; j++) {
-                        is_a_hit = B00000001 == (decimal_representation & B00000001);
-                        decimal_representation >>= 1;
+    if (slot >= number_of_slots) { return; }
 
-                        is_a_hit ? (*current_nibble) |= byte_to_OR_with : (*current_nibble) |= B00000000;
-                        byte_to_OR_with >>= 1;
-                    }
+    if (glyph_cache != nullptr) {
+        byte *cached_rows{ &glyph_cache->rows[slot * slot_size] };
 
-                    current_nibble = &nibble1;
-                }
+        // uploading the same bitmap again wouldn't change anything on the screen
+        if ((glyph_cache->loaded_slots & (1 << slot)) && memcmp(cached_rows, bitmap, number_of_rows) == 0) { return; }
 
-                send_nibbles_to_LCD(nibble1, nibble2);
-        } 
+        memcpy(cached_rows, bitmap, number_of_rows);
+        glyph_cache->loaded_slots |= 1 << slot;
     }
 
-    current_cursor_position++;
-}
+    start_SR_batch();
 
+    set_rs_and_rw(LOW, LOW);
+    send_to_LCD(setCGRAMAddress | (slot * slot_size));
 
+    set_rs_and_rw(HIGH, LOW);
+    for (size_t i{ 0 }; i < number_of_rows; i++) {
+        send_to_LCD(bitmap[i] & B00011111, timing->data_write);
+    }
 
-/*  LCD INTERFACING  */
+    // the address counter is left pointing into CGRAM
+    restore_DDRAM_address();
+
+    end_SR_batch();
+}
 
-void LCD_Setup::moveDisplay(uint8_t &num_of_moves, const bool goRight) {
-    set_rs_and_rw(LOW, LOW);
-    byte byte_to_send, nibble2;
 
-    if (usingShiftRegister) {
-        const bool SR_is_MSB{ (*SR_bit_order_is_MSB) };
+void LCD_Setup::displayCustomCharacter(const uint8_t slot) {
+    set_rs_and_rw(HIGH, LOW);
+    translate_and_send_to_LCD(custom_character_code(slot));
+}
+
+
+void LCD_Setup::useGlyphCache(LCD_GlyphCache *new_glyph_cache) {
+    glyph_cache = new_glyph_cache;
 
-        switch (data_length) {
-            case 8:
-                if (SR_is_MSB) {
-                    goRight ? byte_to_send = B00011000 : byte_to_send = B00111000;
-                }
-                else {
-                    goRight ? byte_to_send =  B00011000 : byte_to_send = B00011100;
-                }
+    if (glyph_cache != nullptr) {
+        memset(glyph_cache->ages, 0, sizeof(glyph_cache->ages));
+        glyph_cache->loaded_slots = 0;
+    }
+}
 
-                for (size_t i{ 0 }; i < num_of_moves; i++) {
-                    SR_func_ptr(byte_to_send);
-                }
 
-                break;
+uint8_t LCD_Setup::loadGlyph(const byte *bitmap) {
+    if (glyph_cache == nullptr) {
+        createCustomCharacter(0, bitmap);
+        return 0;
+    }
 
-            default:
-                byte nibble1;
+    const uint8_t number_of_slots{ (uint8_t)(usingLargeFont ? 4 : 8) };
+    const uint8_t number_of_rows{ (uint8_t)(usingLargeFont ? 11 : 8) };
+    const uint8_t slot_size{ (uint8_t)(usingLargeFont ? 16 : 8) };
+    uint8_t chosen_slot{ number_of_slots };
+    uint8_t least_recently_used_slot{ 0 };
 
-                SR_is_MSB ? nibble1 = B00001000 : nibble1 = B00010000;
+    for (uint8_t i{ 0 }; i < number_of_slots; i++) {
+        const bool isLoaded{ (glyph_cache->loaded_slots & (1 << i)) != 0 };
 
-                if (SR_is_MSB) {
-                    goRight ? nibble2 = B00000001 : nibble2 = B00000011;
-                }
-                else {
-                    goRight ? nibble2 = B10000000 : nibble2 = B11000000;
-                }
+        if (isLoaded && memcmp(&glyph_cache->rows[i * slot_size], bitmap, number_of_rows) == 0) {
+            chosen_slot = i;
+            break;
+        }
 
-                for (size_t i{ 0 }; i < num_of_moves; i++) {
-                    send_nibbles_to_SR(nibble1, nibble2);
-                }
+        // empty slots get used before anything is evicted
+        if (!isLoaded) {
+            if (glyph_cache->loaded_slots & (1 << least_recently_used_slot)) { least_recently_used_slot = i; }
+        }
+        else if ((glyph_cache->loaded_slots & (1 << least_recently_used_slot)) && glyph_cache->ages[i] > glyph_cache->ages[least_recently_used_slot]) {
+            least_recently_used_slot = i;
         }
     }
-    else {
-        switch (data_length) {
-            case 8:
-                goRight ? byte_to_send = B00011000 : byte_to_send = B00111000;
 
-                for (size_t i{ 0 }; i < num_of_moves; i++) {
-                    send_byte_to_LCD(byte_to_send, LCD_cmd_enable_pin_duration);
-                }
+    if (chosen_slot == number_of_slots) {
+        chosen_slot = least_recently_used_slot;
+        createCustomCharacter(chosen_slot, bitmap);
+    }
+
+    for (uint8_t i{ 0 }; i < number_of_slots; i++) {
+        if (glyph_cache->ages[i] < 255) { glyph_cache->ages[i]++; }
+    }
+    glyph_cache->ages[chosen_slot] = 0;
 
-                break;
+    return chosen_slot;
+}
 
-            default:
-                goRight ? nibble2 = B00000001 : nibble2 = B00000011;
 
-                for (size_t i{ 0 }; i < num_of_moves; i++) {
-                    send_nibbles_to_LCD(B00001000, nibble2, LCD_cmd_enable_pin_duration);
-                }
-        }
+void LCD_Setup::displayGlyph(const byte *bitmap) {
+    displayCustomCharacter(loadGlyph(bitmap));
+}
+
+
+void LCD_Setup::useBusyFlag(const bool enable) {
+    // the data pins can't be read back when they're connected to a shift register
+    usingBusyFlag = enable && !usingShiftRegister;
+}
+
+
+void LCD_Setup::startTicker(LCD_Ticker *ticker, const uint8_t display_line, const char *text, const bool useDisplayShift) {
+    ticker->text = text;
+    ticker->length = strlen(text);
+    ticker->first_character = 0;
+    ticker->display_line = display_line;
+    ticker->usesDisplayShift = useDisplayShift;
+
+    if (ticker->length == 0) { return; }
+
+    // the visible blocks start wherever the display has been shifted to
+    for (uint8_t i{ 0 }; i < screen_width(); i++) {
+        write_ticker_character(ticker, display_shift + i, i);
     }
 }
 
 
+void LCD_Setup::scrollTicker(LCD_Ticker *ticker) {
+    if (ticker->length == 0) { return; }
 
-void LCD_Setup::toggleCursor(const uint8_t state, bool isBlinking) {
-    set_rs_and_rw(LOW, LOW);
-    byte nibble2;
-
-    if (usingShiftRegister) {
-        const bool SR_is_MSB{ (*SR_bit_order_is_MSB) };
-        delayMicroseconds(1000);
-
-        switch (data_length) {
-            case 8:
-                if (state == 1) {
-                    if (isBlinking) { 
-                        SR_is_MSB ? SR_func_ptr(B11110000) : SR_func_ptr(B00001111);
-                    }
-                    else {
-                        SR_is_MSB ? SR_func_ptr(B01110000) : SR_func_ptr(B00001110);
-                    }
-                }
-                else {
-                    SR_is_MSB ? SR_func_ptr(B00110000) : SR_func_ptr(B00001100);
-                }
-
-                break;
-
-            default:
-                if (state == 1) {
-                    if (isBlinking) { 
-                        SR_is_MSB ? send_nibbles_to_SR(B00000000, B00001111) : send_nibbles_to_SR(B00000000, B11110000);
-                    }
-                    else {
-                        SR_is_MSB ? send_nibbles_to_SR(B00000000, B00000111) : send_nibbles_to_SR(B00000000, B11100000);
-                    }
-                }
-                else {
-                    SR_is_MSB ? send_nibbles_to_SR(B00000000, B00000011) : send_nibbles_to_SR(B00000000, B11000000);
-                }
-        }
+    const uint8_t width{ screen_width() };
+    ticker->first_character = (ticker->first_character + 1) % ticker->length;
+
+    if (ticker->usesDisplayShift) {
+        // the next character goes in the hidden block right after the visible ones, then shifting the display brings it into view
+        write_ticker_character(ticker, display_shift + width, ticker->first_character + width - 1);
+
+        // the shift is sent straight away, so the new character has to be on the LCD by then
+        if (framebuffer != nullptr) { flush(); }
+
+        uint8_t one_move{ 1 };
+        moveDisplay(one_move, true);
     }
     else {
-        delayMicroseconds(1000);
-
-        switch (data_length) {
-            case 8:
-                if (state == 1) {
-                    byte byte_to_send{ B01110000 };
-                    if (isBlinking) { byte_to_send |= B10000000; }
-
-                    send_byte_to_LCD(byte_to_send, LCD_cmd_enable_pin_duration);
-                }
-                else {
-                    send_byte_to_LCD(B00110000, LCD_cmd_enable_pin_duration);
-                }
-
-                break;
-
-            default:
-                if (state == 1) {
-                    nibble2 = B00000111;
-                    if (isBlinking) { nibble2 |= B00001000; }
-
-                    send_nibbles_to_LCD(B00000000, nibble2, LCD_cmd_enable_pin_duration);
-                }
-                else {
-                    nibble2 = B00000011;
-                    send_nibbles_to_LCD(B00000000, nibble2, LCD_cmd_enable_pin_duration);
-                }
+        // every line shifts with the display, so scrolling just one of them means rewriting it (only the blocks that change are sent when using a framebuffer)
+        for (uint8_t i{ 0 }; i < width; i++) {
+            write_ticker_character(ticker, display_shift + i, ticker->first_character + i);
         }
     }
 }
 
 
+void LCD_Setup::setupBar(LCD_Bar *bar, const uint8_t display_line, const uint8_t block_number, const uint8_t size, const bool isVertical) {
+    bar->display_line = display_line;
+    bar->block_number = block_number;
+    bar->size = size;
+    bar->isVertical = isVertical;
+    bar->drawn_level = 0xFFFF; // makes the first 'drawBar' write every block
 
-void LCD_Setup::moveCursorPosition(uint8_t &display_line, uint8_t &block_number) {
-    set_rs_and_rw(LOW, LOW);
-    const bool SR_is_MSB{ (*SR_bit_order_is_MSB) };
+    drawBar(bar, 0);
+}
 
-    // ensures that the cursor stays within the limits
-    if (display_line < 1) { display_line = 1; } else if (display_line > 2) { display_line = 2; }
-    if (block_number < 1) { block_number = 1; } else if (block_number > character_limit_per_line) { block_number = character_limit_per_line; }
 
-    // moves the cursor to the next line only if the LCD has 2 display lines & is NOT on the 2nd line already
-    if (usingTwoDisplayLines && display_line == 2 && !isAlreadyOnLine2) {
-        isAlreadyOnLine2 = true;
-        uint8_t current_position_alias{ current_cursor_position };
-
-        if (!usingShiftRegister) {
-            switch (data_length) {
-                case 8:
-                    for (; current_position_alias < 40; current_position_alias++) {
-                        send_byte_to_LCD(B00101000, LCD_cmd_enable_pin_duration);
-                    }
-                    break;
-
-                default:
-                    for (; current_position_alias < 40; current_position_alias++) {
-                        send_nibbles_to_LCD(B00001000, B00000010, LCD_cmd_enable_pin_duration);
-                    }
-            }
-        }
-        else {
-            delayMicroseconds(1000);
-            switch (data_length) {
-                case 8:
-                    if (SR_is_MSB) {
-                        for (; current_position_alias < 40; current_position_alias++) {
-                            SR_func_ptr(B00101000);
-                        }
-                    }
-                    else {
-                        for (; current_position_alias < 40; current_position_alias++) {
-                            SR_func_ptr(B00010100);
-                        }
-                    }
-
-                    break;
-
-                default:
-                    if (SR_is_MSB) {
-                        for (; current_position_alias < 40; current_position_alias++) {
-                            send_nibbles_to_SR(B00001000, B00000010);
-                        }
-                    }
-                    else {
-                        for (; current_position_alias < 40; current_position_alias++) {
-                            send_nibbles_to_SR(B00010000, B01000000);
-                        }
-                    }
-            }
+void LCD_Setup::drawBar(LCD_Bar *bar, uint16_t level) {
+    const uint8_t levels_per_block{ bar_levels_per_block(bar->isVertical) };
+    const uint16_t max_level{ (uint16_t)(bar->size * levels_per_block) };
+    if (level > max_level) { level = max_level; }
+
+    for (uint8_t i{ 0 }; i < bar->size; i++) {
+        const uint16_t first_level_of_block{ (uint16_t)(i * levels_per_block) };
+        const uint8_t block_level{ (uint8_t)(level <= first_level_of_block ? 0 : (level - first_level_of_block < levels_per_block ? level - first_level_of_block : levels_per_block)) };
+
+        // only the blocks whose fill has changed are rewritten, which is usually just the one at the end of the bar
+        if (bar->drawn_level != 0xFFFF) {
+            const uint16_t drawn_level{ bar->drawn_level };
+            const uint8_t drawn_block_level{ (uint8_t)(drawn_level <= first_level_of_block ? 0 : (drawn_level - first_level_of_block < levels_per_block ? drawn_level - first_level_of_block : levels_per_block)) };
+
+            if (drawn_block_level == block_level) { continue; }
         }
-        current_cursor_position = 0; // after moving to 2nd display line, reset position tracker
-    }
-
-    // moves the cursor back to the first display line only if it was on the second
-    else if (usingTwoDisplayLines && display_line == 1 && isAlreadyOnLine2) {
-        isAlreadyOnLine2 = false;
-        uint8_t current_position_alias = current_cursor_position + 40;
-
-        if (!usingShiftRegister) {
-            switch (data_length) {
-                case 8:
-                    for (; current_position_alias != current_cursor_position; current_position_alias--) {
-                        send_byte_to_LCD(B00001000, LCD_cmd_enable_pin_duration);
-                    }
-                    break;
-
-                default:
-                    for (; current_position_alias != current_cursor_position; current_position_alias--) {
-                        send_nibbles_to_LCD(B00001000, B00000000, LCD_cmd_enable_pin_duration);
-                    }
-            }
+
+        // vertical bars grow upwards from their first block
+        if (bar->isVertical) {
+            if (bar->display_line <= i) { break; }
+            write_character_at(bar->display_line - i, bar->block_number, bar_block_character(block_level, true));
         }
         else {
-            delayMicroseconds(1000);
-            switch (data_length) {
-                case 8:
-                    if (SR_is_MSB) {
-                        for (; current_position_alias != current_cursor_position; current_position_alias--) {
-                            SR_func_ptr(B00001000);
-                        }
-                    }
-                    else {
-                        for (; current_position_alias != current_cursor_position; current_position_alias--) {
-                            SR_func_ptr(B00010000);
-                        }
-                    }
-
-                    break;
-
-                default:
-                    if (SR_is_MSB) {
-                        for (; current_position_alias != current_cursor_position; current_position_alias--) {
-                            send_nibbles_to_SR(B00001000, B00000000);
-                        }
-                    }
-                    else {
-                        for (; current_position_alias != current_cursor_position; current_position_alias--) {
-                            send_nibbles_to_SR(B00010000, B00000000);
-                        }
-                    }
-            }
+            write_character_at(bar->display_line, bar->block_number + i, bar_block_character(block_level, false));
         }
     }
 
+    bar->drawn_level = level;
+}
 
 
-    // this part moves the cursor along a display line
-    if (!usingShiftRegister) {
-        switch (data_length) {
-            case 8:
-                if (current_cursor_position > block_number) {
-                    for (; current_cursor_position > block_number; current_cursor_position--) {
-                        send_byte_to_LCD(B00101000, LCD_cmd_enable_pin_duration);
-                    }
-                }
-                else {
-                    for (; current_cursor_position < block_number; current_cursor_position++) {
-                        send_byte_to_LCD(B00001000, LCD_cmd_enable_pin_duration);
-                    }
-                }
-
-                break;
-
-            default:
-                if (current_cursor_position > block_number) {
-                    for (; current_cursor_position > block_number; current_cursor_position--) {
-                        send_nibbles_to_LCD(B00001000, B00000000, LCD_cmd_enable_pin_duration);
-                    }
-                }
-                else {
-                    for (; current_cursor_position < block_number; current_cursor_position++) {
-                        send_nibbles_to_LCD(B00001000, B00000010, LCD_cmd_enable_pin_duration);
-                    }
-                }
-        }
+void LCD_Setup::drawSparkline(const uint8_t display_line, const uint8_t block_number, const uint8_t *levels, const uint8_t number_of_levels) {
+    // one block per level, each filled from the bottom like a vertical bar
+    for (uint8_t i{ 0 }; i < number_of_levels; i++) {
+        write_character_at(display_line, block_number + i, bar_block_character(levels[i], true));
+    }
+}
+
+
+void LCD_Setup::setupField(LCD_Field *field, const uint8_t display_line, const uint8_t right_edge, const uint8_t width) {
+    field->display_line = display_line;
+    field->right_edge = right_edge < 1 ? 1 : (right_edge > character_limit_per_line ? character_limit_per_line : right_edge);
+    field->width = width < 1 ? 1 : (width > field->right_edge ? field->right_edge : width);
+    field->drawn_length = field->width; // makes the first 'displayField' blank the whole field
+}
+
+
+void LCD_Setup::backlightON() {
+    toggle_backlight(true);
+}
+
+
+void LCD_Setup::backlightOFF() {
+    toggle_backlight(false);
+}
+
+
+#ifdef LCD_collect_stats
+LCD_Stats LCD_Setup::getStats() {
+#ifdef __AVR__
+    // 'service' may be updating the counters from a timer interrupt
+    const uint8_t old_SREG{ SREG };
+    cli();
+    const LCD_Stats snapshot{ stats };
+    SREG = old_SREG;
+
+    return snapshot;
+#else
+    return stats;
+#endif
+}
+
+
+void LCD_Setup::resetStats() {
+    memset(&stats, 0, sizeof(stats));
+}
+#endif
+
+
+void LCD_Setup::setVisibleColumns(const uint8_t columns, const bool wrap) {
+    visible_columns = columns < character_limit_per_line ? columns : 0;
+    wrapsAtVisibleColumns = wrap;
+}
+
+
+size_t LCD_Setup::write(uint8_t character) {
+    return display_characters((const char *)&character, 1);
+}
+
+
+size_t LCD_Setup::write(const uint8_t *buffer, size_t size) {
+    return write((const char *)buffer, size);
+}
+
+
+size_t LCD_Setup::write(const char *characters, const size_t length) {
+    return display_characters(characters, length);
+}
+
+
+size_t LCD_Setup::write(const char *str) {
+    return write(str, strlen(str));
+}
+
+
+size_t LCD_Setup::write_P(const char *flash_str) {
+    size_t length{ 0 };
+    size_t written{ 0 };
+
+    set_rs_and_rw(HIGH, LOW);
+    start_SR_batch();
+
+    // each character is read from flash as it's sent, so the string is never copied to RAM
+    for (char current_char{ (char)pgm_read_byte(flash_str) }; current_char != '\0'; current_char = (char)pgm_read_byte(flash_str + ++length)) {
+        written += translate_and_send_to_LCD(current_char);
+    }
+
+    end_SR_batch();
+
+    return written;
+}
+
+
+size_t LCD_Setup::write(const __FlashStringHelper *flash_str) {
+    return write_P(reinterpret_cast<const char *>(flash_str));
+}
+
+
+size_t LCD_Setup::write(const String &str) {
+    return write(str.c_str(), str.length());
+}
+
+
+
+
+
+
+/*  BITWISE MANIPULATION  */
+
+void LCD_Setup::toggle_enable_pin(const unsigned int delay) {
+    pulse_enable_pin();
+
+    // the LCD only starts executing on the falling edge of the enable pin. A delay of 0 is used by the transmit queue, which times the execution itself
+    if (delay == 0) { return; }
+
+    if (usingBusyFlag) {
+        wait_until_LCD_is_ready(delay); // 'delay' becomes the timeout, so a missing busy flag falls back to the fixed duration
     }
     else {
-        delayMicroseconds(1000);
-        byte byte_to_send, nibble1, nibble2;
-
-        switch (data_length) {
-            case 8:
-                if (current_cursor_position > block_number) {
-                    SR_is_MSB ? byte_to_send = B00101000 : byte_to_send = B00010100;
-
-                    for (; current_cursor_position > block_number; current_cursor_position--) {
-                        SR_func_ptr(byte_to_send);
-                    }
-                }
-                else {
-                    SR_is_MSB ? byte_to_send = B00001000 : byte_to_send = B00010000;
-
-                    for (; current_cursor_position < block_number; current_cursor_position++) {
-                        SR_func_ptr(byte_to_send);
-                    }
-                }
-
-                break;
-
-            default:
-                SR_is_MSB ? nibble1 = B00001000 : nibble1 = B00010000;
-
-                if (current_cursor_position > block_number) {
-                    for (; current_cursor_position > block_number; current_cursor_position--) {
-                        send_nibbles_to_SR(nibble1, B00000000);
-                    }
-                }
-                else {
-                    SR_is_MSB ? nibble2 = B00000010 : nibble2 = B01000000;
-
-                    for (; current_cursor_position < block_number; current_cursor_position++) {
-                        send_nibbles_to_SR(nibble1, nibble2);
-                    }
-                }
+        delayMicroseconds(delay);
+        LCD_count_stat(blocked_microseconds, delay);
+    }
+}
+
+
+
+void LCD_Setup::pulse_enable_pin() {
+#ifdef LCD_port_registers
+    const uint8_t old_SREG{ SREG };
+    cli(); // the read-modify-write must not be interrupted by anything else writing to the same port
+
+    *en_port |= en_pin_mask;
+    delayMicroseconds(1); // enable pulse width must be at least 450 ns (pg 49 of the datasheet)
+    *en_port &= ~en_pin_mask;
+
+    LCD_count_stat(GPIO_writes, 2);
+    LCD_count_stat(blocked_microseconds, 1);
+
+    SREG = old_SREG;
+#else
+    digitalWrite(en_pin, HIGH);
+    delayMicroseconds(1); // enable pulse width must be at least 450 ns (pg 49 of the datasheet)
+    digitalWrite(en_pin, LOW);
+
+    LCD_count_stat(GPIO_writes, 2);
+    LCD_count_stat(blocked_microseconds, 1);
+#endif
+}
+
+
+
+byte LCD_Setup::read_busy_flag_and_address() {
+    const uint8_t pin_array_size{ (uint8_t)(usingEightBitMode ? 8 : 4) };
+    byte busy_flag_and_address{ B00000000 };
+
+    // 4-bit mode reads the busy flag & upper 3 address bits first, then the lower 4 address bits
+    for (size_t i{ 0 }; i < 8 / pin_array_size; i++) {
+        digitalWrite(en_pin, HIGH);
+        delayMicroseconds(1); // data delay time is at most 360 ns
+
+        for (size_t j{ 0 }; j < pin_array_size; j++) {
+            busy_flag_and_address <<= 1;
+            busy_flag_and_address |= digitalRead(pin_arrays.DL8_pin_array[j]);
         }
+
+        digitalWrite(en_pin, LOW);
+        delayMicroseconds(1);
+
+        LCD_count_stat(GPIO_writes, 2);
     }
+
+    return busy_flag_and_address;
 }
 
 
 
-void LCD_Setup::display_to_LCD(double user_num) {
-    set_rs_and_rw(HIGH, LOW);
-    uint_fast64_t integral_copy{ (uint_fast64_t)user_num };
-    display_to_LCD(integral_copy);
+void LCD_Setup::wait_until_LCD_is_ready(const unsigned int timeout) {
+    const uint8_t pin_array_size{ (uint8_t)(usingEightBitMode ? 8 : 4) };
+    const unsigned long start_time{ micros() };
+
+    // with the pull-ups, a bus that the LCD doesn't drive reads as busy, so the timeout takes over instead of the loop ending straight away
+    for (size_t i{ 0 }; i < pin_array_size; i++) {
+        pinMode(pin_arrays.DL8_pin_array[i], INPUT_PULLUP);
+    }
+
+    digitalWrite(rs_pin, LOW);
+    digitalWrite(rw_pin, HIGH);
+    LCD_count_stat(GPIO_writes, 2);
 
-    // the following section converts the part after the decimal point into a regular integer
-    double fractional_copy = user_num - integral_copy;
-    double temporary_copy{ fractional_copy };
-    bool hasOverflown{ false };
-    size_t  num_of_iterations{ 0 };
+    // DB7 is the busy flag; give up once the worst-case execution time has passed
+    while ((read_busy_flag_and_address() & B10000000) && (micros() - start_time) < timeout) {}
 
-    while ((temporary_copy - (int)(temporary_copy)) <= 0.999) {
-        temporary_copy *= 10;
-        num_of_iterations++;
+    LCD_count_stat(blocked_microseconds, micros() - start_time);
 
-        if (num_of_iterations > 10) { hasOverflown = true; break; }
+    set_rs_and_rw(rs_is_high ? HIGH : LOW, LOW);
+
+    for (size_t i{ 0 }; i < pin_array_size; i++) {
+        pinMode(pin_arrays.DL8_pin_array[i], OUTPUT);
     }
+}
+
+
+
+void LCD_Setup::set_rs_and_rw(const unsigned int rs_state, const unsigned int rw_state) {
+    rs_is_high = rs_state == HIGH;
+
+    // queued transactions carry their own register select state, and the pins may be in use by 'service'
+    if (transmit_queue != nullptr) { return; }
 
-    if (!hasOverflown) {
-        for (size_t i{ 0 }; i < num_of_iterations; i++) {
-            fractional_copy *= 10;
-            if ((int)fractional_copy == 0) { display(0); }
+    write_rs_and_rw(rs_state, rw_state);
+}
+
+
+
+void LCD_Setup::write_rs_and_rw(const unsigned int rs_state, const unsigned int rw_state) {
+    // with the control pins on the shift register, rs is part of every frame. A frame with only the new state is added so that rs settles before en rises
+    if (sends_SR_frames()) {
+        const byte new_control_bits{ (byte)((rs_state == HIGH ? SR_rs_bit_mask : B00000000) | SR_backlight_bit_mask) };
+
+        if (new_control_bits != SR_control_bits) {
+            SR_control_bits = new_control_bits;
+            add_SR_frame(SR_control_bits);
         }
 
-        display_to_LCD(".");
-        display_to_LCD((uint_fast64_t)fractional_copy);
+        return;
+    }
+
+    digitalWrite(rs_pin, rs_state);
+    digitalWrite(rw_pin, rw_state);
+    LCD_count_stat(GPIO_writes, 2);
+}
+
+
+
+#ifdef LCD_port_registers
+void LCD_Setup::find_pin_ports(const uint8_t pin_array_size) {
+    en_port = portOutputRegister(digitalPinToPort(en_pin));
+    en_pin_mask = digitalPinToBitMask(en_pin);
+
+    if (pin_array_size == 0) { return; }
+
+    // the port can only be written in one go if every data pin is on it
+    const uint8_t port{ digitalPinToPort(pin_arrays.DL8_pin_array[0]) };
+
+    for (size_t i{ 0 }; i < pin_array_size; i++) {
+        if (digitalPinToPort(pin_arrays.DL8_pin_array[i]) != port) {
+            data_port = nullptr;
+            return;
+        }
+
+        data_pin_masks[i] = digitalPinToBitMask(pin_arrays.DL8_pin_array[i]);
+        data_port_mask |= data_pin_masks[i];
+    }
+
+    data_port = portOutputRegister(port);
+}
+#endif
+
+
+
+void LCD_Setup::write_to_data_pins(byte bits, const uint8_t pin_array_size) {
+#ifdef LCD_port_registers
+    if (data_port != nullptr) {
+        byte port_bits{ B00000000 };
+
+        for (size_t i{ 0 }; i < pin_array_size; i++) {
+            if (bits & B00000001) { port_bits |= data_pin_masks[i]; }
+            bits >>= 1;
+        }
+
+        const uint8_t old_SREG{ SREG };
+        cli();
+        *data_port = (*data_port & ~data_port_mask) | port_bits;
+        SREG = old_SREG;
+
+        LCD_count_stat(GPIO_writes, 1);
+
+        return;
+    }
+#endif
+
+    for (size_t i{ 0 }; i < pin_array_size; i++) {
+        digitalWrite(pin_arrays.DL8_pin_array[i], (bits & B00000001));
+        bits >>= 1;
+    }
+
+    LCD_count_stat(GPIO_writes, pin_array_size);
+}
+
+
+
+void LCD_Setup::send_byte_to_LCD(byte byte_to_send, const uint_fast16_t enable_timing, const uint8_t pin_array_size) {
+    write_to_data_pins(byte_to_send, pin_array_size);
+    toggle_enable_pin(enable_timing);
+}
+
+
+
+void LCD_Setup::send_nibbles_to_LCD(const byte nibble1, const byte nibble2, const uint_fast16_t enable_timing) {
+    byte current_nibble{ nibble1 };
+
+    for (size_t i{ 0 }; i < 2; i++) {
+        write_to_data_pins(current_nibble, 4);
+        current_nibble = nibble2;
+
+        // the LCD only executes the byte once both nibbles have been sent, so there's nothing to wait for in between
+        i == 0 ? pulse_enable_pin() : toggle_enable_pin(enable_timing);
+    }
+}
+
+
+
+void LCD_Setup::send_nibbles_to_SR(const byte nibble1, const byte nibble2, const uint_fast16_t enable_timing) {
+    SR_func_ptr(nibble1);
+    pulse_enable_pin();
+    SR_func_ptr(nibble2);
+    LCD_count_stat(SR_calls, 2);
+    toggle_enable_pin(enable_timing);
+}
+
+
+
+byte LCD_Setup::reverse_bit_order(const byte byte_to_reverse) {
+    return pgm_read_byte(&reversed_bytes[byte_to_reverse]);
+}
+
+
+
+template <uint8_t DATA_LENGTH, bool USING_SHIFT_REGISTER, bool SR_IS_MSB>
+void LCD_Setup::encode_and_send(const byte byte_to_send, const uint_fast16_t enable_timing) {
+    // 'byte_to_send' is in datasheet bit order (db7 -> db0). The pin arrays start at db7, so the direct and MSB shift register wirings need it reversed
+    const byte encoded_byte{ SR_IS_MSB ? reverse_bit_order(byte_to_send) : byte_to_send };
+
+    // every condition below is a template parameter, so each instantiation compiles down to a single path
+    if (USING_SHIFT_REGISTER) {
+        if (DATA_LENGTH == 8) {
+            SR_func_ptr(encoded_byte);
+            LCD_count_stat(SR_calls, 1);
+            toggle_enable_pin(enable_timing);
+        }
+        else if (SR_IS_MSB) {
+            send_nibbles_to_SR(encoded_byte & B00001111, encoded_byte >> 4, enable_timing);
+        }
+        else {
+            send_nibbles_to_SR(encoded_byte & B11110000, encoded_byte << 4, enable_timing);
+        }
+    }
+    else {
+        if (DATA_LENGTH == 8) {
+            send_byte_to_LCD(encoded_byte, enable_timing);
+        }
+        else {
+            send_nibbles_to_LCD(encoded_byte & B00001111, encoded_byte >> 4, enable_timing);
+        }
+    }
+}
+
+
+
+template <bool SR_IS_MSB>
+void LCD_Setup::encode_into_SR_frames(const byte byte_to_send, const uint_fast16_t enable_timing) {
+    if (SR_IS_MSB) {
+        const byte reversed_byte{ reverse_bit_order(byte_to_send) };
+
+        add_SR_nibble_frames(reversed_byte & B00001111);
+        add_SR_nibble_frames(reversed_byte >> 4);
+    }
+    else {
+        add_SR_nibble_frames(byte_to_send & B11110000);
+        add_SR_nibble_frames(byte_to_send << 4);
+    }
+
+    // while a string is being written, the time the shift register takes to clock out the next byte's frames covers the LCD's execution time, unless the transport is faster than the LCD
+    if (!isBatchingSRFrames || SR_byte_time < enable_timing) {
+        send_SR_frames();
+        delayMicroseconds(enable_timing);
+        LCD_count_stat(blocked_microseconds, enable_timing);
+    }
+}
+
+
+
+void LCD_Setup::add_SR_frame(const byte frame) {
+    if (SR_frames->count == LCD_SR_buffer_size) { send_SR_frames(); }
+
+    SR_frames->frames[SR_frames->count++] = frame;
+}
+
+
+
+void LCD_Setup::add_SR_nibble_frames(const byte nibble_bits) {
+    // the LCD reads the nibble when en falls, so the same bits are sent with en high and then low
+    add_SR_frame(nibble_bits | SR_control_bits | SR_en_bit_mask);
+    add_SR_frame(nibble_bits | SR_control_bits);
+}
+
+
+
+void LCD_Setup::send_SR_frames() {
+    if (SR_frames->count == 0) { return; }
+
+    const unsigned long start_time{ micros() };
+
+    I2C_func_ptr != nullptr ? I2C_func_ptr(I2C_address, SR_frames->frames, SR_frames->count) : SR_buffer_func_ptr(SR_frames->frames, SR_frames->count);
+    const unsigned long call_time{ micros() - start_time };
+    LCD_count_stat(SR_calls, 1);
+    LCD_count_stat(blocked_microseconds, call_time);
+
+    // a byte is 4 frames; interrupts can only make a call slower, so the shortest time is kept
+    const unsigned long byte_time{ call_time * 4 / SR_frames->count };
+    if (byte_time < SR_byte_time) { SR_byte_time = byte_time; }
+
+    SR_frames->count = 0;
+}
+
+
+
+#ifdef LCD_collect_stats
+void LCD_Setup::count_transaction(const byte byte_to_send) {
+    if (rs_is_high) {
+        stats.data_bytes++;
+        return;
+    }
+
+    // an instruction's opcode is its highest set bit (clear display = 0 ... set DDRAM address = 7)
+    uint8_t opcode{ 7 };
+    while (opcode > 0 && !(byte_to_send & (1 << opcode))) { opcode--; }
+
+    stats.command_bytes[opcode]++;
+}
+
+
+
+void LCD_Setup::record_latency(uint32_t &max_latency, const uint32_t latency) {
+    if (latency > max_latency) { max_latency = latency; }
+}
+#endif
+
+
+
+bool LCD_Setup::sends_SR_frames() {
+    return SR_buffer_func_ptr != nullptr || I2C_func_ptr != nullptr;
+}
+
+
+
+void LCD_Setup::toggle_backlight(const bool isOn) {
+    // only the I2C backpack has a backlight pin
+    if (I2C_func_ptr == nullptr) { return; }
+
+    SR_backlight_bit_mask = isOn ? B00001000 : B00000000;
+    SR_control_bits = (SR_control_bits & ~B00001000) | SR_backlight_bit_mask;
+
+    // queued transactions pick the new state up with their next frame
+    if (transmit_queue != nullptr) { return; }
+
+    add_SR_frame(SR_control_bits);
+    send_SR_frames();
+}
+
+
+
+void LCD_Setup::start_SR_batch() {
+    // queued transactions are sent one at a time by 'service', so only the blocking mode batches them
+    isBatchingSRFrames = sends_SR_frames() && transmit_queue == nullptr;
+}
+
+
+
+void LCD_Setup::end_SR_batch() {
+    if (!isBatchingSRFrames) { return; }
+
+    isBatchingSRFrames = false;
+    send_SR_frames();
+    delayMicroseconds(timing->data_write);
+    LCD_count_stat(blocked_microseconds, timing->data_write);
+}
+
+
+
+void LCD_Setup::send_function_set_nibble(const byte function_set, const uint_fast16_t enable_timing) {
+    if (usingEightBitMode) {
+        (this->*encode_and_send_to_LCD)(function_set, enable_timing);
+        return;
+    }
+
+    // same nibble positions as the encoders use for the upper nibble
+    const byte upper_nibble_bits{ (byte)(SR_bit_order_is_MSB ? reverse_bit_order(function_set) & B00001111 : function_set & B11110000) };
+
+    if (sends_SR_frames()) {
+        add_SR_nibble_frames(upper_nibble_bits);
+        send_SR_frames();
+        delayMicroseconds(enable_timing);
+        LCD_count_stat(blocked_microseconds, enable_timing);
+    }
+    else if (usingShiftRegister) {
+        SR_func_ptr(upper_nibble_bits);
+        LCD_count_stat(SR_calls, 1);
+        toggle_enable_pin(enable_timing);
+    }
+    else {
+        write_to_data_pins(upper_nibble_bits, 4);
+        toggle_enable_pin(enable_timing);
+    }
+}
+
+
+
+void LCD_Setup::select_encoder() {
+    if (sends_SR_frames()) {
+        encode_and_send_to_LCD = SR_bit_order_is_MSB ? &LCD_Setup::encode_into_SR_frames<true> : &LCD_Setup::encode_into_SR_frames<false>;
+    }
+    else if (!usingShiftRegister) {
+        // the direct wiring uses the same (reversed) bit order as an MSB shift register
+        encode_and_send_to_LCD = usingEightBitMode ? &LCD_Setup::encode_and_send<8, false, true> : &LCD_Setup::encode_and_send<4, false, true>;
+    }
+    else if (usingEightBitMode) {
+        encode_and_send_to_LCD = SR_bit_order_is_MSB ? &LCD_Setup::encode_and_send<8, true, true> : &LCD_Setup::encode_and_send<8, true, false>;
+    }
+    else {
+        encode_and_send_to_LCD = SR_bit_order_is_MSB ? &LCD_Setup::encode_and_send<4, true, true> : &LCD_Setup::encode_and_send<4, true, false>;
+    }
+}
+
+
+
+void LCD_Setup::send_to_LCD(const byte byte_to_send, const uint_fast16_t enable_timing, const bool is_function_set_nibble) {
+#ifdef LCD_collect_stats
+    count_transaction(byte_to_send);
+#endif
+
+    if (transmit_queue == nullptr) {
+        is_function_set_nibble ? send_function_set_nibble(byte_to_send, enable_timing) : (this->*encode_and_send_to_LCD)(byte_to_send, enable_timing);
+        return;
+    }
+
+    LCD_TransmitQueue *queue{ transmit_queue };
+    const uint8_t next_head{ (uint8_t)((queue->head + 1) % LCD_transmit_queue_size) };
+
+    // a full queue makes the caller wait for room instead of losing the transaction
+    if (next_head == queue->tail) {
+        queue->overflow_count++;
+
+        LCD_start_blocked_timer();
+        while (next_head == queue->tail) { service(); }
+        LCD_stop_blocked_timer();
+    }
+
+    queue->transactions[queue->head].value = byte_to_send;
+    queue->transactions[queue->head].is_data = rs_is_high;
+    queue->transactions[queue->head].is_function_set_nibble = is_function_set_nibble;
+    queue->transactions[queue->head].execution_time = enable_timing;
+    queue->head = next_head;
+
+    const uint8_t queued_transactions{ (uint8_t)((next_head + LCD_transmit_queue_size - queue->tail) % LCD_transmit_queue_size) };
+    if (queued_transactions > queue->high_water_mark) { queue->high_water_mark = queued_transactions; }
+}
+
+
+
+void LCD_Setup::send_to_LCD(const byte instruction) {
+    send_to_LCD(instruction, timing->command);
+}
+
+
+
+bool LCD_Setup::translate_and_send_to_LCD(byte decimal_representation) {
+    // past the visible columns, characters are either dropped or continued at the start of the next line (see 'setVisibleColumns')
+    if (visible_columns != 0 && (uint8_t)(current_cursor_position - page_start) > visible_columns) {
+        if (!wrapsAtVisibleColumns) { return false; }
+
+        uint8_t next_line{ (uint8_t)(usingTwoDisplayLines && !isAlreadyOnLine2 ? 2 : 1) };
+        uint8_t first_block{ 1 };
+
+        moveCursorPosition(next_line, first_block);
+        set_rs_and_rw(HIGH, LOW);
+    }
+
+    write_character(decimal_representation);
+
+    return true;
+}
+
+
+
+void LCD_Setup::write_character(const byte decimal_representation) {
+    if (framebuffer != nullptr) {
+        // blocks past the end of the last line are dropped, just like the LCD would
+        const uint8_t framebuffer_index{ cursor_index() };
+
+        if (framebuffer_index < LCD_DDRAM_size) {
+            framebuffer->characters[framebuffer_index] = decimal_representation;
+        }
+    }
+    else {
+        send_character_to_LCD(decimal_representation);
+    }
+
+    // the LCD goes from the end of the 1st line to the start of the 2nd, and from the end of the last line back to the start of the 1st
+    if (++current_cursor_position > character_limit_per_line) {
+        current_cursor_position = 1;
+        isAlreadyOnLine2 = usingTwoDisplayLines && !isAlreadyOnLine2;
+    }
+}
+
+
+
+void LCD_Setup::send_character_to_LCD(const byte decimal_representation) {
+    send_to_LCD(decimal_representation, timing->data_write);
+}
+
+
+
+uint8_t LCD_Setup::screen_width() {
+    return visible_columns != 0 ? visible_columns : LCD_default_visible_columns;
+}
+
+
+
+uint8_t LCD_Setup::page_block(const uint8_t block_number) {
+    return (block_number - 1 + page_start) % character_limit_per_line + 1;
+}
+
+
+
+uint8_t LCD_Setup::cursor_index() {
+    // same layout as the framebuffer: blocks are counted line by line from 0
+    return current_cursor_position - 1 + (isAlreadyOnLine2 ? character_limit_per_line : 0);
+}
+
+
+
+uint8_t LCD_Setup::framebuffer_index_to_DDRAM_address(const uint8_t framebuffer_index) {
+    if (usingTwoDisplayLines && framebuffer_index >= character_limit_per_line) {
+        return framebuffer_index - character_limit_per_line + DDRAM_line2_offset;
+    }
+
+    return framebuffer_index;
+}
+
+
+
+void LCD_Setup::restore_DDRAM_address() {
+    // the framebuffer knows where the LCD's cursor actually is, which may not be the logical cursor
+    uint8_t index{ framebuffer != nullptr ? framebuffer->LCD_cursor_index : cursor_index() };
+    if (index >= LCD_DDRAM_size) { index = 0; }
+
+    if (framebuffer != nullptr) { framebuffer->LCD_cursor_index = index; }
+
+    set_rs_and_rw(LOW, LOW);
+    send_to_LCD(setDDRAMAddress | framebuffer_index_to_DDRAM_address(index));
+}
+
+
+
+byte LCD_Setup::custom_character_code(const uint8_t slot) {
+    // with the 5x10 font, bits 1-2 of the code pick the slot and bit 0 is ignored (pg 19-20 of the datasheet)
+    return usingLargeFont ? slot << 1 : slot;
+}
+
+
+
+/*  LCD INTERFACING  */
+
+void LCD_Setup::moveDisplay(uint8_t &num_of_moves, const bool goRight) {
+    // the lines are rings of 40 blocks (80 on one line), so going the other way round may take fewer shifts
+    uint8_t shifts{ (uint8_t)(num_of_moves % character_limit_per_line) };
+    bool shiftsRight{ goRight };
+
+    if (shifts > character_limit_per_line / 2) {
+        shifts = character_limit_per_line - shifts;
+        shiftsRight = !goRight;
+    }
+
+    display_shift = (display_shift + (goRight ? num_of_moves % character_limit_per_line : character_limit_per_line - num_of_moves % character_limit_per_line)) % character_limit_per_line;
+
+    set_rs_and_rw(LOW, LOW);
+
+    for (size_t i{ 0 }; i < shifts; i++) {
+        send_to_LCD(shiftsRight ? shiftDisplayLeft : shiftDisplayRight);
+    }
+}
+
+
+
+void LCD_Setup::write_ticker_character(const LCD_Ticker *ticker, const uint8_t block_index, const size_t character_index) {
+    // the ticker's blocks are counted from the start of the line, not the page
+    write_character_at(ticker->display_line, (block_index + character_limit_per_line - page_start) % character_limit_per_line + 1, ticker->text[character_index % ticker->length]);
+}
+
+
+
+void LCD_Setup::write_character_at(uint8_t display_line, uint8_t block_number, const byte decimal_representation) {
+    // the address counter already points at the block when the blocks are written in order
+    if (current_cursor_position != page_block(block_number) || isAlreadyOnLine2 != (usingTwoDisplayLines && display_line == 2)) {
+        moveCursorPosition(display_line, block_number);
+    }
+
+    set_rs_and_rw(HIGH, LOW);
+    write_character(decimal_representation);
+}
+
+
+
+void LCD_Setup::set_entry_mode(const bool decrements) {
+    if (isDecrementing == decrements) { return; }
+
+    isDecrementing = decrements;
+
+    set_rs_and_rw(LOW, LOW);
+    send_to_LCD(decrements ? entrySet_decr_shift0 : entrySet_incr_shift0);
+}
+
+
+
+uint8_t LCD_Setup::start_field(const LCD_Field *field) {
+    uint8_t display_line{ field->display_line };
+    uint8_t block_number{ field->right_edge };
+
+    start_SR_batch();
+
+    // the framebuffer is written by index, so only the LCD itself needs decrement mode
+    if (framebuffer == nullptr) { set_entry_mode(true); }
+
+    moveCursorPosition(display_line, block_number);
+    set_rs_and_rw(HIGH, LOW);
+
+    // on a page the right edge can wrap round to near the start of the line, which leaves fewer blocks for the field
+    return field->width < current_cursor_position ? field->width : current_cursor_position;
+}
+
+
+
+void LCD_Setup::write_field_character(const uint8_t offset, const byte decimal_representation) {
+    if (framebuffer != nullptr) {
+        framebuffer->characters[cursor_index() - offset] = decimal_representation;
+        return;
+    }
+
+    send_character_to_LCD(decimal_representation);
+}
+
+
+
+void LCD_Setup::end_field(LCD_Field *field, const uint8_t length, const uint8_t width) {
+    uint8_t written{ length };
+
+    // leftover characters of a longer number are blanked; the blocks further left already are
+    for (; written < field->drawn_length && written < width; written++) {
+        write_field_character(written, ' ');
+    }
+
+    field->drawn_length = length;
+
+    if (framebuffer == nullptr) { set_entry_mode(false); }
+
+    end_SR_batch();
+
+    // the address counter is left on the block before the field's leftmost written character, which wraps to the end of the other line from block 1
+    current_cursor_position -= written;
+
+    if (current_cursor_position == 0) {
+        current_cursor_position = character_limit_per_line;
+        isAlreadyOnLine2 = usingTwoDisplayLines && !isAlreadyOnLine2;
+    }
+}
+
+
+
+byte LCD_Setup::bar_block_character(const uint8_t block_level, const bool isVertical) {
+    const uint8_t levels_per_block{ bar_levels_per_block(isVertical) };
+
+    // empty & full blocks are in the LCD's font already
+    if (block_level == 0) { return ' '; }
+    if (block_level >= levels_per_block) { return LCD_full_block_character; }
+
+    // horizontal bars fill up from the left column, vertical ones from the bottom row
+    byte bitmap[11]{ };
+    const uint8_t number_of_rows{ (uint8_t)(usingLargeFont ? 11 : 8) };
+
+    for (uint8_t row{ 0 }; row < number_of_rows; row++) {
+        if (isVertical) {
+            bitmap[row] = row >= levels_per_block - block_level && row < levels_per_block ? B00011111 : B00000000;
+        }
+        else {
+            bitmap[row] = (byte)(B00011111 << (5 - block_level)) & B00011111;
+        }
+    }
+
+    return custom_character_code(loadGlyph(bitmap));
+}
+
+
+
+uint8_t LCD_Setup::bar_levels_per_block(const bool isVertical) {
+    // the 5x10 font's 11th row is only used by the cursor
+    return isVertical ? (usingLargeFont ? 10 : 8) : 5;
+}
+
+
+
+void LCD_Setup::toggleCursor(const uint8_t state, bool isBlinking) {
+    set_rs_and_rw(LOW, LOW);
+    byte display_control{ display1_cursor0_blink0 };
+
+    if (state == 1) {
+        display_control |= B00000010;
+        if (isBlinking) { display_control |= B00000001; }
+    }
+
+    send_to_LCD(display_control);
+}
+
+
+
+void LCD_Setup::moveCursorPosition(uint8_t &display_line, uint8_t &block_number) {
+    // ensures that the cursor stays within the limits
+    if (display_line < 1) { display_line = 1; } else if (display_line > 2) { display_line = 2; }
+    if (block_number < 1) { block_number = 1; } else if (block_number > character_limit_per_line) { block_number = character_limit_per_line; }
+
+    block_number = page_block(block_number);
+
+    isAlreadyOnLine2 = usingTwoDisplayLines && display_line == 2;
+    current_cursor_position = block_number;
+
+    // a single 'set DDRAM address' instruction reaches any block, no matter how far away it is
+    byte DDRAM_address{ (byte)(block_number - 1) };
+    if (isAlreadyOnLine2) { DDRAM_address += DDRAM_line2_offset; }
+
+    // the framebuffer places the LCD's cursor during 'flush'
+    if (framebuffer != nullptr) { return; }
+
+    set_rs_and_rw(LOW, LOW);
+    send_to_LCD(setDDRAMAddress | DDRAM_address);
+}
+
+
+
+void LCD_Setup::display_to_LCD(char user_char) {
+    display_characters(&user_char, 1);
+}
+
+
+
+void LCD_Setup::display_to_LCD(const __FlashStringHelper *flash_str) {
+    write(flash_str);
+}
+
+
+
+void LCD_Setup::display_to_LCD(const String &str) {
+    write(str);
+}
+
+
+
+size_t LCD_Setup::display_characters(const char *characters, const size_t length) {
+    size_t written{ 0 };
+
+    set_rs_and_rw(HIGH, LOW);
+    start_SR_batch();
+
+    for (size_t i{ 0 }; i < length; i++) {
+        written += translate_and_send_to_LCD(characters[i]);
+    }
+
+    end_SR_batch();
+
+    return written;
+}
+
+
+
+void LCD_Setup::display_to_LCD(double user_num) {
+    displayDecimal(user_num);
+}
+
+
+
+void LCD_Setup::display_to_LCD(float user_num) {
+    displayDecimal(user_num);
+}
+
+
+
+uint32_t LCD_Setup::power_of_10(const uint8_t exponent) {
+    uint32_t result{ 1 };
+
+    for (uint8_t i{ 0 }; i < exponent; i++) { result *= 10; }
+
+    return result;
+}
+
+
+
+void LCD_Setup::display_scaled_number(const bool isNegative, unsigned long long magnitude, uint8_t decimal_places) {
+    if (decimal_places > 9) { decimal_places = 9; }
+
+    // filled in from the right: up to 20 digits, the decimal point and the sign
+    char characters[24];
+    uint8_t first_character{ sizeof(characters) };
+    uint8_t digit_count{ 0 };
+
+    // the fraction keeps its leading zeros and there's always at least one digit before the decimal point
+    while (magnitude != 0 || digit_count <= decimal_places) {
+        if (digit_count == decimal_places && decimal_places != 0) { characters[--first_character] = '.'; }
+
+        uint8_t digit;
+
+        // 64-bit division is only needed until the number fits in 32 bits, which is much cheaper on AVR
+        if (magnitude > 0xFFFFFFFF) {
+            const unsigned long long quotient{ magnitude / 10 };
+            digit = magnitude - quotient * 10;
+            magnitude = quotient;
+        }
+        else {
+            const uint32_t quotient{ (uint32_t)magnitude / 10 };
+            digit = (uint32_t)magnitude - quotient * 10;
+            magnitude = quotient;
+        }
+
+        characters[--first_character] = '0' + digit;
+        digit_count++;
+    }
+
+    if (isNegative) { characters[--first_character] = '-'; }
+
+    display_characters(&characters[first_character], sizeof(characters) - first_character);
+}
+
+
+
+void LCD_Setup::displayDecimal(const double number, const uint8_t decimal_places) {
+    const uint8_t places{ (uint8_t)(decimal_places > 9 ? 9 : decimal_places) };
+    const bool isNegative{ number < 0 };
+
+    if (number != number) {
+        display_characters("nan", 3);
+        return;
+    }
+
+    // one multiplication and one conversion are the only floating-point steps; adding 0.5 rounds half away from zero
+    const double scaled_magnitude{ (isNegative ? -number : number) * power_of_10(places) + 0.5 };
+
+    if (scaled_magnitude >= 18446744073709551615.0) {
+        display_characters("ovf", 3);
+        return;
+    }
+
+    const unsigned long long rounded_magnitude{ (unsigned long long)scaled_magnitude };
+
+    display_scaled_number(isNegative && rounded_magnitude != 0, rounded_magnitude, places);
+}
+
+
+
+
+
+
+/*  SHARED BUS  */
+
+LCD_Bus::LCD_Bus(LCD_Setup **bus_displays, LCD_TransmitQueue *queues, const uint8_t bus_number_of_displays)
+    : displays{ bus_displays }, number_of_displays{ bus_number_of_displays } {
+    for (uint8_t i{ 0 }; i < number_of_displays; i++) {
+        displays[i]->useTransmitQueue(&queues[i]);
+        displays[i]->bus_lock = &isInUse;
+    }
+}
+
+
+
+void LCD_Bus::service() {
+    // a display only uses the bus when its LCD has finished the previous transaction, so the others' execution times overlap with it
+    for (uint8_t i{ 0 }; i < number_of_displays; i++) {
+        displays[(next_display + i) % number_of_displays]->service();
+    }
+
+    next_display = (next_display + 1) % number_of_displays;
+}
+
+
+
+void LCD_Bus::flush() {
+    for (uint8_t i{ 0 }; i < number_of_displays; i++) {
+        while (!displays[i]->isQueueEmpty()) { service(); }
+    }
+}
+
+
+
+
+
+
+
+/*  HARDWARE SPI SHIFT REGISTER  */
+
+#ifdef LCD_SPI_shift_register
+#ifdef LCD_port_registers
+static volatile uint8_t *SPI_latch_port{ nullptr };
+static uint8_t SPI_latch_pin_mask{ 0 };
+#else
+static uint8_t SPI_latch_pin{ 0 };
+#endif
+
+
+
+static void latch_SPI_byte() {
+    while (!(SPSR & _BV(SPIF))) {}
+
+    // the 74HC595 copies its shift register to the outputs on the rising edge of the latch pin
+#ifdef LCD_port_registers
+    const uint8_t old_SREG{ SREG };
+    cli(); // the read-modify-write must not be interrupted by anything else writing to the same port
+
+    *SPI_latch_port |= SPI_latch_pin_mask;
+    *SPI_latch_port &= ~SPI_latch_pin_mask;
+
+    SREG = old_SREG;
+#else
+    digitalWrite(SPI_latch_pin, HIGH);
+    digitalWrite(SPI_latch_pin, LOW);
+#endif
+}
+
+
+
+void LCD_SPI_begin(const uint8_t latch_pin) {
+#ifdef LCD_port_registers
+    SPI_latch_port = portOutputRegister(digitalPinToPort(latch_pin));
+    SPI_latch_pin_mask = digitalPinToBitMask(latch_pin);
+#else
+    SPI_latch_pin = latch_pin;
+#endif
+
+    pinMode(latch_pin, OUTPUT);
+    digitalWrite(latch_pin, LOW);
+
+    // SS has to be an output for the SPI to stay in master mode
+    pinMode(SS, OUTPUT);
+    pinMode(MOSI, OUTPUT);
+    pinMode(SCK, OUTPUT);
+
+    // master, MSB first (same as shiftOut with MSBFIRST), mode 0, clock / 2
+    SPCR = _BV(SPE) | _BV(MSTR);
+    SPSR |= _BV(SPI2X);
+}
+
+
+
+void LCD_SPI_send_byte(byte binary_data) {
+    SPDR = binary_data;
+    latch_SPI_byte();
+}
+
+
+
+void LCD_SPI_send_buffer(const byte *bytes, const size_t count) {
+    for (size_t i{ 0 }; i < count; i++) {
+        // the next frame is clocked into the shift register while the outputs still hold the previous one
+        SPDR = bytes[i];
+        delayMicroseconds(LCD_SPI_frame_duration);
+
+        latch_SPI_byte();
     }
 }
+#endif
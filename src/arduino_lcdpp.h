@@ -28,9 +28,11 @@ SETUP NOTES:
 - three possible ways to set up the LCD:
     1. No shift register (i.e. all 3 control pins are directly connected to the Arduino)
     2. Shift register for data pins of LCD but NOT its control pins
-    3. Shift register for both control & data pins (N/A)
+    3. Shift register for both control & data pins (4-bit only; rw must be tied to ground)
 
-'rs', 'rw', and 'en' will not be required for the 3rd way
+'rs', 'rw', and 'en' will not be required for the 3rd way. Instead, the shift register outputs that rs & en are wired to are passed as bit numbers, and the data nibble takes
+the other half of the register (db7 -> db4 on bits 0-3 when MSB, db4 -> db7 on bits 4-7 when LSB). A whole string is handed to the shift register function as one buffer of bytes, 2 per nibble, which is collected
+in the LCD_SRFrames passed to the constructor.
 
 
 DDRAM & CGRAM NOTES:
@@ -49,84 +51,401 @@ CURSOR & DISPLAY NOTES:
 
 */
 
-// LCD function set commands
-#define funcset_DL8_MSB B00001100
-#define funcset_DL8_LSB B00110000
-#define funcset_DL4_MSB B00000100
-#define funcset_DL4_LSB B00100000
+// LCD instructions in datasheet bit order (db7 -> db0); they're encoded for the wiring in use right before being sent
+#define clearLCD B00000001
+#define returnLCDHome B00000010
+#define display1_cursor0_blink0 B00001100
+#define shiftDisplayLeft B00011000
+#define shiftDisplayRight B00011100
+#define setCGRAMAddress B01000000 // OR the address into the lower 6 bits
+#define setDDRAMAddress B10000000 // OR the address into the lower 7 bits
+#define DDRAM_line2_offset 0x40
+
+// LCD instructions used when initializing (datasheet bit order)
+#define functionSet_DL8 B00110000 // OR with B00001000 for 2 display lines and B00000100 for the 5x10 font
+#define functionSet_DL4 B00100000
+#define entrySet_incr_shift0 B00000110
+#define entrySet_decr_shift0 B00000100 // used by 'displayField', which writes from right to left
+
+#define LCD_DDRAM_size 80
+
+#define LCD_default_decimal_places 2
+#define LCD_full_block_character 0xFF // character code of the solid block in the LCD's font
+#define LCD_default_visible_columns 16 // width of the screen for tickers & pages when 'setVisibleColumns' hasn't been called
+
+// How long the LCD's controller takes to execute each kind of instruction, in microseconds (see 'useTimingProfile')
+struct LCD_TimingProfile {
+    uint16_t data_write; // writing a character or a custom character row, including the address counter update
+    uint16_t command;
+    uint16_t clear_and_home; // clear display & return home
+    uint16_t first_function_set; // waits after the first 2 function sets of the initialization by instruction
+    uint16_t second_function_set;
+    uint16_t power_rise; // wait before the initialization when the LCD has just been switched on
+};
+
+extern const LCD_TimingProfile LCD_HD44780_timing; // Hitachi HD44780 at 270 kHz, with some margin (default)
+extern const LCD_TimingProfile LCD_ST7066U_timing; // Sitronix ST7066U
+extern const LCD_TimingProfile LCD_KS0066_timing; // Samsung KS0066 at 250 kHz
+extern const LCD_TimingProfile LCD_fast_OLED_timing; // character OLEDs with a WS0010-type controller (fast writes, slow clears)
+
+// How 'begin' waits for the LCD's power to rise after it's switched on
+enum LCD_PowerOn : uint8_t {
+    LCD_wait_for_power_rise, // always waits the full power rise time of the timing profile
+    LCD_wait_since_boot, // only waits until the power rise time has passed since the board started, for LCDs powered on with the board (default)
+    LCD_power_is_stable // doesn't wait, e.g. after a reset that didn't switch the LCD off
+};
 
-// LCD clear display command
-#define clearLCD_DL8_MSB B10000000
-#define clearLCD_DL8_LSB B00000001
-#define clearLCD_DL4_MSB B00001000
-#define clearLCD_DL4_LSB B00010000
+// Passed first to a constructor (e.g. 'LCD_Setup mylcd(LCD_begin_later, 12, 11, 10, ...)') to stop it from calling 'begin'
+struct LCD_BeginLater {};
+constexpr LCD_BeginLater LCD_begin_later{};
 
-// LCD return home command
-#define returnLCDHome_DL8_MSB B01000000
-#define returnLCDHome_DL8_LSB B00000010
-#define returnLCDHome_DL4_MSB B00000100
-#define returnLCDHome_DL4_LSB B00100000
+// Define 'LCD_manual_begin' (as a build flag, since the library's source file has to see it) to make that the default for every constructor
 
-// LCD display command (default has display on and no cursor or blink)
-#define display1_cursor0_blink0_DL8_MSB B00110000
-#define display1_cursor0_blink0_DL8_LSB B00001100
-#define display1_cursor0_blink0_DL4_MSB B00000011
-#define display1_cursor0_blink0_DL4_LSB B11000000
+// On AVR boards the data & enable pins are written straight to the port registers; define 'LCD_use_digitalWrite' to always use digitalWrite instead
+#if defined(__AVR__) && !defined(LCD_use_digitalWrite)
+#define LCD_port_registers
+#endif
 
-// LCD entry mode command (default has I/D set to increment & shifting disabled)
-#define entryset_incr_shift0_DL8_MSB B01100000
-#define entryset_incr_shift0_DL8_LSB B00000110
-#define entryset_incr_shift0_DL4_MSB B00000110
-#define entryset_incr_shift0_DL4_LSB B01100000
+// Bytes the library collects before calling the buffered shift register function; longer strings are split into several calls
+#ifndef LCD_SR_buffer_size
+#define LCD_SR_buffer_size 64
+#endif
 
+// Frames waiting to be handed to the buffered shift register or I2C function (see the 3rd & 4th constructors). Each of those LCDs needs its own, the others don't need one at all
+struct LCD_SRFrames {
+    byte frames[LCD_SR_buffer_size];
+    uint8_t count;
+};
 
+// The built-in 74HC595 functions use the AVR's SPI peripheral (data -> MOSI, clock -> SCK, latch -> any pin)
+#if defined(__AVR__) && defined(SPDR)
+#define LCD_SPI_shift_register
+
+// Time each frame of a buffer is held on the shift register. A byte sent to the LCD is 4 frames, so this covers the default execution time; bytes that need longer are sent one at a time
+#ifndef LCD_SPI_frame_duration
+#define LCD_SPI_frame_duration 11
+#endif
+#endif
+
+#ifndef LCD_transmit_queue_size
+#define LCD_transmit_queue_size 32
+#endif
+
+// Define 'LCD_collect_stats' (as a build flag) to count what the library sends and how long it blocks (see 'getStats'); without it the counters take no RAM or time
+#ifdef LCD_collect_stats
+#define LCD_count_stat(counter, amount) (stats.counter += (amount))
+#define LCD_start_call_timer() const unsigned long call_start_time{ micros() }
+#define LCD_stop_call_timer(max_latency) record_latency(stats.max_latency, micros() - call_start_time)
+// the blocked time counted in between (e.g. by 'service') is part of the measured time, so it's replaced rather than added to
+#define LCD_start_blocked_timer() const unsigned long blocked_start_time{ micros() }; const uint32_t blocked_before{ stats.blocked_microseconds }
+#define LCD_stop_blocked_timer() (stats.blocked_microseconds = blocked_before + (micros() - blocked_start_time))
+#else
+#define LCD_count_stat(counter, amount)
+#define LCD_start_call_timer()
+#define LCD_stop_call_timer(max_latency)
+#define LCD_start_blocked_timer()
+#define LCD_stop_blocked_timer()
+#endif
+
+// Off-screen copy of the LCD's DDRAM (see 'useFramebuffer'). Blocks are stored line by line, i.e. 80 on one display line or 40 + 40 on two
+struct LCD_Framebuffer {
+    byte characters[LCD_DDRAM_size];
+    byte sent_characters[LCD_DDRAM_size];
+    uint8_t LCD_cursor_index;
+};
 
-#define LCD_data_enable_pin_duration 3000
-#define LCD_cmd_enable_pin_duration 37
+// Copy of the bitmaps loaded in the LCD's custom character slots (see 'useGlyphCache'). Slots are 8 rows apart, or 16 with the 5x10 font
+struct LCD_GlyphCache {
+    byte rows[64];
+    uint8_t ages[8]; // number of glyph loads since each slot was last used
+    uint8_t loaded_slots; // one bit per slot
+};
+
+// A line of text that scrolls from right to left and starts over once it reaches its end (see 'startTicker')
+struct LCD_Ticker {
+    const char *text;
+    size_t length;
+    size_t first_character; // index of the character in the leftmost visible block
+    uint8_t display_line;
+    bool usesDisplayShift;
+};
+
+// A bar that fills up from left to right, or from the bottom up, drawn with custom characters (see 'setupBar')
+struct LCD_Bar {
+    uint8_t display_line; // line & block of the leftmost (or bottom) block
+    uint8_t block_number;
+    uint8_t size; // number of blocks
+    bool isVertical;
+    uint16_t drawn_level; // level that's on the screen, so that only the blocks that change get rewritten
+};
+
+// A right-aligned number that's rewritten in place (see 'setupField')
+struct LCD_Field {
+    uint8_t display_line;
+    uint8_t right_edge; // block of the field's last character
+    uint8_t width;
+    uint8_t drawn_length; // characters of the number that's on the screen, so that only those get blanked
+};
+
+// One byte waiting to be sent to the LCD, along with how long the LCD takes to execute it
+struct LCD_Transaction {
+    byte value;
+    bool is_data : 1;
+    bool is_function_set_nibble : 1; // only the upper nibble is sent in 4-bit mode (see 'begin')
+    uint16_t execution_time;
+};
+
+// Ring buffer for the non-blocking mode (see 'useTransmitQueue'). The counters can be read at any time to size the queue
+struct LCD_TransmitQueue {
+    volatile LCD_Transaction transactions[LCD_transmit_queue_size];
+    volatile uint8_t head;
+    volatile uint8_t tail;
+    uint8_t high_water_mark; // most transactions that were ever waiting at once
+    uint16_t overflow_count; // times the sketch had to wait for room in the queue
+    unsigned long last_transfer_time;
+    uint16_t current_execution_time;
+};
+
+#ifdef LCD_collect_stats
+// Counters collected since the LCD was set up or 'resetStats' was called. Latencies are the longest calls in microseconds, including the time spent waiting on the LCD
+struct LCD_Stats {
+    uint32_t data_bytes;
+    uint32_t command_bytes[8]; // indexed by the instruction's highest set bit: 0 = clear display, 1 = return home, 2 = entry mode, 3 = display control, 4 = cursor/display shift, 5 = function set, 6 = CGRAM address, 7 = DDRAM address
+    uint32_t GPIO_writes; // digitalWrite calls and port register writes
+    uint32_t SR_calls; // calls to the shift register or I2C function
+    uint32_t blocked_microseconds; // time spent in delays, polling the busy flag, shift register/I2C calls and waiting for room in the transmit queue
+    uint32_t max_display_latency;
+    uint32_t max_moveCursor_latency;
+    uint32_t max_clearDisplay_latency;
+};
+#endif
+
+// Unsigned counterpart of each integer type, so that numbers can be split into digits without overflowing on the most negative value
+template <typename INT_TYPE> struct LCD_unsigned { typedef INT_TYPE type; };
+template <> struct LCD_unsigned<char> { typedef unsigned char type; };
+template <> struct LCD_unsigned<signed char> { typedef unsigned char type; };
+template <> struct LCD_unsigned<short> { typedef unsigned short type; };
+template <> struct LCD_unsigned<int> { typedef unsigned int type; };
+template <> struct LCD_unsigned<long> { typedef unsigned long type; };
+template <> struct LCD_unsigned<long long> { typedef unsigned long long type; };
+
+// 'number < 0' for any integer type; a bool can't be negative, and comparing it with 0 is a warning
+template <typename INT_TYPE> inline bool LCD_is_negative(const INT_TYPE number) { return number < 0; }
+inline bool LCD_is_negative(const bool) { return false; }
+
+// Sends frames to a PCF8574 I2C backpack, as many as fit in Wire's buffer per transmission. Wire.h has to be included before this header
+#ifdef TwoWire_h
+#ifndef LCD_I2C_buffer_size
+#ifdef BUFFER_LENGTH
+#define LCD_I2C_buffer_size BUFFER_LENGTH
+#else
+#define LCD_I2C_buffer_size 32
+#endif
+#endif
+
+inline void LCD_I2C_send(const uint8_t address, const byte *bytes, const size_t count) {
+    for (size_t i{ 0 }; i < count; i += LCD_I2C_buffer_size) {
+        Wire.beginTransmission(address);
+        Wire.write(&bytes[i], count - i < LCD_I2C_buffer_size ? count - i : LCD_I2C_buffer_size);
+        Wire.endTransmission();
+    }
+}
+#endif
+
+#ifdef LCD_SPI_shift_register
+// Shift register functions that can be passed to the constructors in place of your own ('LCD_SPI_send_byte' to the 2nd, 'LCD_SPI_send_buffer' to the 3rd)
+void LCD_SPI_begin(const uint8_t latch_pin);
+void LCD_SPI_send_byte(byte binary_data);
+void LCD_SPI_send_buffer(const byte *bytes, const size_t count);
+#endif
+
+class LCD_Setup : public Print {
+    friend class LCD_Bus;
 
-class LCD_Setup {
     private:
-        const uint8_t *rs_pin{ nullptr };
-        const uint8_t *rw_pin{ nullptr };
-        const uint8_t *en_pin{ nullptr };
-        const uint8_t *LCD_data_length{ nullptr };
-        const uint8_t data_length{ (*LCD_data_length) };
-        bool usingTwoDisplayLines{ false };
+        uint8_t rs_pin;
+        uint8_t rw_pin;
+        uint8_t en_pin;
+
+        // the configuration & state flags are packed into 2 bytes, which adds up when several displays are driven from the Uno's 2 KB of RAM
+        bool usingEightBitMode : 1;
+        bool usingTwoDisplayLines : 1;
+        bool usingShiftRegister : 1;
+        bool SR_bit_order_is_MSB : 1;
+        bool usingBusyFlag : 1;
+        bool rs_is_high : 1;
+        bool isAlreadyOnLine2 : 1;
+        bool usingLargeFont : 1;
+        bool isBatchingSRFrames : 1;
+        bool wrapsAtVisibleColumns : 1;
+        bool isDecrementing : 1; // entry mode of the LCD's address counter (I/D = 0)
+
         union pin_arrays_union {
             uint8_t DL8_pin_array[8];
             uint8_t DL4_pin_array[4];
         } pin_arrays;
 
-        bool usingShiftRegister{ false };
-        const bool *SR_bit_order_is_MSB{ nullptr };
+#ifdef LCD_port_registers
+        volatile uint8_t *data_port{ nullptr }; // stays nullptr when the data pins are spread across several ports
+        uint8_t data_port_mask{ 0 };
+        uint8_t data_pin_masks[8];
+        volatile uint8_t *en_port{ nullptr };
+        uint8_t en_pin_mask{ 0 };
+
+        void find_pin_ports(const uint8_t pin_array_size);
+#endif
+
         void (*SR_func_ptr)(byte){ nullptr };
 
+        // only used when the control pins are on the shift register too
+        void (*SR_buffer_func_ptr)(const byte *bytes, const size_t count){ nullptr };
+        LCD_SRFrames *SR_frames{ nullptr }; // also used with an I2C backpack
+        uint16_t SR_byte_time{ 0xFFFF }; // how long the function takes to send a byte's frames (see 'send_SR_frames')
+        byte SR_rs_bit_mask{ 0 };
+        byte SR_en_bit_mask{ 0 };
+        volatile byte SR_control_bits{ 0 }; // written by 'service' as well
+
+        // only used with an I2C backpack
+        void (*I2C_func_ptr)(const uint8_t address, const byte *bytes, const size_t count){ nullptr };
+        uint8_t I2C_address{ 0 };
+        byte SR_backlight_bit_mask{ 0 };
+
+        LCD_Framebuffer *framebuffer{ nullptr };
+
+        LCD_GlyphCache *glyph_cache{ nullptr };
+
+        LCD_TransmitQueue *transmit_queue{ nullptr };
+        volatile bool isServicingQueue{ false };
+        volatile bool *bus_lock{ nullptr }; // used instead of 'isServicingQueue' when the pins are shared with other displays (see 'LCD_Bus')
+
         uint8_t current_cursor_position{ 1 };
         uint8_t character_limit_per_line{ 80 };
-        bool isAlreadyOnLine2{ false };
+        uint8_t visible_columns{ 0 }; // 0 when the whole line is used
+        uint8_t display_shift{ 0 }; // block of each line that's at the left edge of the screen
+        uint8_t page_start{ 0 }; // blocks are counted from here while drawing a page (see 'beginPage')
+
+        const LCD_TimingProfile *timing{ &LCD_HD44780_timing };
+
+#ifdef LCD_collect_stats
+        LCD_Stats stats{};
+
+        void count_transaction(const byte byte_to_send);
+
+        static void record_latency(uint32_t &max_latency, const uint32_t latency);
+#endif
 
         void toggle_enable_pin(const unsigned int delay);
 
+        void pulse_enable_pin();
+
+        byte read_busy_flag_and_address();
+
+        void wait_until_LCD_is_ready(const unsigned int timeout);
+
         void set_rs_and_rw(const unsigned int rs_state, const unsigned int rw_state);
 
-        void send_byte_to_LCD(byte byte_to_send, const uint_fast16_t enable_timing = LCD_data_enable_pin_duration, const uint8_t pin_array_size = 8);
+        void write_rs_and_rw(const unsigned int rs_state, const unsigned int rw_state);
+
+        void write_to_data_pins(byte bits, const uint8_t pin_array_size);
+
+        void send_byte_to_LCD(byte byte_to_send, const uint_fast16_t enable_timing, const uint8_t pin_array_size = 8);
+
+        void send_nibbles_to_LCD(const byte nibble1, const byte nibble2, const uint_fast16_t enable_timing);
 
-        void send_nibbles_to_LCD(const byte nibble1, const byte nibble2, const uint_fast16_t enable_timing = LCD_data_enable_pin_duration);
+        void send_nibbles_to_SR(const byte nibble1, const byte nibble2, const uint_fast16_t enable_timing);
 
-        void send_nibbles_to_SR(const byte nibble1, const byte nibble2, const uint_fast16_t enable_timing = LCD_cmd_enable_pin_duration);
+        static byte reverse_bit_order(const byte byte_to_reverse);
+
+        // picked once by the constructor, so the wiring isn't re-checked for every byte
+        void (LCD_Setup::*encode_and_send_to_LCD)(const byte byte_to_send, const uint_fast16_t enable_timing){ nullptr };
+
+        template <uint8_t DATA_LENGTH, bool USING_SHIFT_REGISTER, bool SR_IS_MSB>
+        void encode_and_send(const byte byte_to_send, const uint_fast16_t enable_timing);
+
+        template <bool SR_IS_MSB>
+        void encode_into_SR_frames(const byte byte_to_send, const uint_fast16_t enable_timing);
+
+        void add_SR_frame(const byte frame);
+
+        void add_SR_nibble_frames(const byte nibble_bits);
+
+        void send_SR_frames();
+
+        bool sends_SR_frames();
+
+        void toggle_backlight(const bool isOn);
+
+        void start_SR_batch();
+
+        void end_SR_batch();
+
+        void send_function_set_nibble(const byte function_set, const uint_fast16_t enable_timing);
+
+        void select_encoder();
+
+        void send_to_LCD(const byte byte_to_send, const uint_fast16_t enable_timing, const bool is_function_set_nibble = false);
+
+        // sends an instruction that takes the profile's usual command time
+        void send_to_LCD(const byte instruction);
 
         void moveCursorPosition(uint8_t &display_line, uint8_t &block_number);
 
-        void translate_and_send_to_LCD(byte decimal_representation);
+        bool translate_and_send_to_LCD(byte decimal_representation);
+
+        void write_character(const byte decimal_representation);
+
+        void send_character_to_LCD(const byte decimal_representation);
+
+        uint8_t cursor_index();
+
+        uint8_t framebuffer_index_to_DDRAM_address(const uint8_t framebuffer_index);
+
+        void restore_DDRAM_address();
+
+        // the character code that shows a custom character slot
+        byte custom_character_code(const uint8_t slot);
 
         void moveDisplay(uint8_t &num_of_moves, const bool goRight = false);
 
-        void toggleCursor(const uint8_t state, bool isBlinking = false);
+        void write_ticker_character(const LCD_Ticker *ticker, const uint8_t block_index, const size_t character_index);
+
+        uint8_t screen_width();
+
+        uint8_t page_block(const uint8_t block_number);
+
+        void write_character_at(uint8_t display_line, uint8_t block_number, const byte decimal_representation);
+
+        void set_entry_mode(const bool decrements);
+
+        // returns how many of the field's blocks fit between the start of the line and its right edge
+        uint8_t start_field(const LCD_Field *field);
+
+        void write_field_character(const uint8_t offset, const byte decimal_representation);
+
+        void end_field(LCD_Field *field, const uint8_t length, const uint8_t width);
+
+        byte bar_block_character(const uint8_t block_level, const bool isVertical);
+
+        uint8_t bar_levels_per_block(const bool isVertical);
 
-        void display() {}
+        void toggleCursor(const uint8_t state, bool isBlinking = false);
 
         void display_to_LCD(double user_num);
 
+        void display_to_LCD(float user_num);
+
+        void display_to_LCD(char user_char);
+
+        void display_to_LCD(const __FlashStringHelper *flash_str);
+
+        void display_to_LCD(const String &str);
+
+        size_t display_characters(const char *characters, const size_t length);
+
+        static uint32_t power_of_10(const uint8_t exponent);
+
+        void display_scaled_number(const bool isNegative, unsigned long long magnitude, uint8_t decimal_places);
+
         template<typename STR_PTR_TYPE>
         void display_to_LCD(STR_PTR_TYPE *user_str);
 
@@ -139,19 +458,101 @@ class LCD_Setup {
 
         LCD_Setup(const uint8_t rs, const uint8_t rw, const uint8_t en, const uint8_t data_length, const bool has2DisplayLines, const bool has5x10Font, void (*SR_func)(byte) = nullptr, const bool SR_is_MSB = true);
 
+        // 'SR_frame_buffer' collects the frames of a string so that they're sent in one call; it has to stay in memory while the LCD is used
+        LCD_Setup(const bool has2DisplayLines, const bool has5x10Font, void (*SR_buffer_func)(const byte *bytes, const size_t count), LCD_SRFrames *SR_frame_buffer, const uint8_t SR_rs_bit, const uint8_t SR_en_bit, const bool SR_is_MSB = true);
 
-        // Writes characters to the screen
-        template <typename STR_TYPE, typename... PACK_ARGS>
-        void display(STR_TYPE *parameter, PACK_ARGS... parameter_pack) {
-            display_to_LCD(parameter);
-            display(parameter_pack...);
-        }
-        template <typename NON_STR_TYPE, typename... PACK_ARGS>
-        void display(NON_STR_TYPE parameter, PACK_ARGS... parameter_pack) {
-            display_to_LCD(parameter);
-            display(parameter_pack...);
+        // the same constructors without the call to 'begin'
+        LCD_Setup(const LCD_BeginLater, const uint8_t rs, const uint8_t rw, const uint8_t en, const uint8_t data_length, const bool has2DisplayLines, const bool has5x10Font, const uint8_t d7pin, const uint8_t d6pin, const uint8_t d5pin, const uint8_t d4pin, const uint8_t d3pin = 0, const uint8_t d2pin = 0, const uint8_t d1pin = 0, const uint8_t d0pin = 0);
+
+        LCD_Setup(const LCD_BeginLater, const uint8_t rs, const uint8_t rw, const uint8_t en, const uint8_t data_length, const bool has2DisplayLines, const bool has5x10Font, void (*SR_func)(byte) = nullptr, const bool SR_is_MSB = true);
+
+        LCD_Setup(const LCD_BeginLater, const bool has2DisplayLines, const bool has5x10Font, void (*SR_buffer_func)(const byte *bytes, const size_t count), LCD_SRFrames *SR_frame_buffer, const uint8_t SR_rs_bit, const uint8_t SR_en_bit, const bool SR_is_MSB = true);
+
+        // PCF8574 I2C backpack; pass 'LCD_I2C_send' (available once Wire.h is included) and call 'begin' in 'setup', after Wire.begin()
+        LCD_Setup(const uint8_t I2C_backpack_address, const bool has2DisplayLines, const bool has5x10Font, void (*I2C_func)(const uint8_t address, const byte *bytes, const size_t count), LCD_SRFrames *SR_frame_buffer);
+
+        // Makes every wait in the library use the given controller's execution times. Call it before 'begin' (i.e. with 'LCD_begin_later') for the initialization to use them too
+        void useTimingProfile(const LCD_TimingProfile *profile);
+
+        // Sets up the pins and initializes the LCD. The constructors call it unless given 'LCD_begin_later' or 'LCD_manual_begin' is defined; call 'useBusyFlag' first to poll the busy flag during
+        // the initialization, or 'useTransmitQueue' to queue it (power rise wait included) and return straight away
+        void begin(const LCD_PowerOn power_on = LCD_wait_since_boot);
+
+
+        // Writes characters to the screen. Each argument is handed straight to its own 'display_to_LCD', so a call only adds one small function however many arguments it has
+        template <typename... PACK_ARGS>
+        void display(const PACK_ARGS &... parameter_pack) {
+            LCD_start_call_timer();
+
+            const int expand_pack[]{ 0, (display_to_LCD(parameter_pack), 0)... };
+            (void)expand_pack;
+
+            LCD_stop_call_timer(max_display_latency);
         }
 
+        // Print's 'write' functions, which 'print' & 'println' (and the ones below) go through
+        size_t write(uint8_t character) override;
+        size_t write(const uint8_t *buffer, size_t size) override;
+        using Print::write;
+
+        // Writes 'length' characters in one go; returns the number of characters written
+        size_t write(const char *characters, const size_t length);
+        size_t write(const char *str);
+        size_t write(const String &str);
+
+        // Writes a string stored in flash (PSTR or F) without copying it to RAM
+        size_t write_P(const char *flash_str);
+        size_t write(const __FlashStringHelper *flash_str);
+
+        // Writes 'text' on a line so that 'scrollTicker' can scroll it. With 'useDisplayShift', each step writes 1 character and shifts the display, which scrolls
+        // every line; otherwise only the ticker's line scrolls, but it's rewritten on every step. 'text' has to stay in memory while the ticker is used
+        void startTicker(LCD_Ticker *ticker, const uint8_t display_line, const char *text, const bool useDisplayShift = true);
+
+        // Scrolls the ticker's text one block to the left
+        void scrollTicker(LCD_Ticker *ticker);
+
+        // Draws an empty bar of 'size' blocks, starting at the given block and going right (or up, when vertical)
+        void setupBar(LCD_Bar *bar, const uint8_t display_line, const uint8_t block_number, const uint8_t size, const bool isVertical = false);
+
+        // Fills the bar up to 'level': 5 levels per block for horizontal bars, and 8 (or 10 with the 5x10 font) for vertical ones
+        void drawBar(LCD_Bar *bar, uint16_t level);
+
+        // Draws a row of 1-block vertical bars, one for each level (0 to 8, or 10 with the 5x10 font)
+        void drawSparkline(const uint8_t display_line, const uint8_t block_number, const uint8_t *levels, const uint8_t number_of_levels);
+
+        // Sets up a field of 'width' blocks that ends at 'right_edge'. The first 'displayField' blanks the whole field
+        void setupField(LCD_Field *field, const uint8_t display_line, const uint8_t right_edge, const uint8_t width);
+
+        // Writes an integer right-aligned in the field, from its last digit to its first, and blanks only the blocks that the previous number used.
+        // Numbers too long for the field lose their leftmost digits
+        template <typename INT_TYPE>
+        void displayField(LCD_Field *field, const INT_TYPE number);
+
+        // Sets how many columns of each line are visible. Characters past them continue on the next line, or are dropped if 'wrap' is false (0 uses the whole line)
+        void setVisibleColumns(const uint8_t columns, const bool wrap = true);
+
+        // Writes an integer in any base from 2 to 16 (others are clamped to that range), right-aligned in 'width' blocks and padded with spaces (or zeros)
+        template <typename INT_TYPE>
+        void displayNumber(const INT_TYPE number, const uint8_t base = 10, const uint8_t width = 0, const bool zero_padding = false);
+
+        // Writes a floating-point number rounded to the given number of decimal places (at most 9)
+        void displayDecimal(const double number, const uint8_t decimal_places = LCD_default_decimal_places);
+
+        // Writes a binary fixed-point number, e.g. Q16.16 (16 fraction bits), rounded to the given number of decimal places without any floating-point math
+        template <typename INT_TYPE>
+        void displayFixed(const INT_TYPE number, const uint8_t fraction_bits = 16, const uint8_t decimal_places = LCD_default_decimal_places);
+
+        // Writes an integer that's been scaled by a power of 10, e.g. 2150 with 2 decimal places is written as 21.50
+        template <typename INT_TYPE>
+        void displayScaled(const INT_TYPE number, const uint8_t decimal_places);
+
+        // Starts drawing the next page in the DDRAM columns that are off the screen (blanking them first, unless 'clearPage' is false). Until 'flipPage',
+        // 'moveCursor' & co count blocks from the start of that page
+        void beginPage(const bool clearPage = true);
+
+        // Shifts the display so that the page drawn since 'beginPage' is shown in one go
+        void flipPage();
+
         // Moves the screen to the left
         void moveDisplayLeft(uint8_t num_of_moves = 1);
 
@@ -164,6 +565,10 @@ class LCD_Setup {
         // Hides cursor
         void cursorOFF();
 
+        // Turns the backlight of an I2C backpack on or off
+        void backlightON();
+        void backlightOFF();
+
         // Moves the cursor and the screen back to the starting position  
         void resetPositions();
 
@@ -172,6 +577,69 @@ class LCD_Setup {
 
         // Deletes all the characters on the screen, including the cursor
         void clearDisplay();
+
+        // Redirects everything written to the screen into 'new_framebuffer' until 'flush' is called (nullptr switches back to writing directly)
+        void useFramebuffer(LCD_Framebuffer *new_framebuffer);
+
+        // Sends only the characters that changed in the framebuffer since the last flush
+        void flush() override;
+
+        // Queues everything sent to the LCD in 'new_transmit_queue' instead of waiting for it, so 'service' has to be called regularly (nullptr goes back to blocking)
+        void useTransmitQueue(LCD_TransmitQueue *new_transmit_queue);
+
+        // Sends the next queued transaction once the LCD has finished the previous one; safe to call from a timer interrupt
+        void service();
+
+        // True when every queued transaction has been sent (always true without a queue)
+        bool isQueueEmpty();
+
+#ifdef LCD_collect_stats
+        // Returns a copy of the counters, so they can be compared before & after a piece of code
+        LCD_Stats getStats();
+
+        // Sets every counter back to 0
+        void resetStats();
+#endif
+
+        // Stores a custom character's bitmap (one byte per row, 5 lowest bits used) in one of the 8 slots, or 4 with the 5x10 font
+        void createCustomCharacter(const uint8_t slot, const byte *bitmap);
+
+        // Writes the custom character stored in the given slot
+        void displayCustomCharacter(const uint8_t slot);
+
+        // Lets 'loadGlyph' & 'displayGlyph' share the custom character slots between any number of bitmaps (nullptr turns it off)
+        void useGlyphCache(LCD_GlyphCache *new_glyph_cache);
+
+        // Returns the slot holding 'bitmap', uploading it over the least recently used slot if it isn't loaded yet
+        uint8_t loadGlyph(const byte *bitmap);
+
+        // Writes 'bitmap' as a custom character, loading it first if needed
+        void displayGlyph(const byte *bitmap);
+
+        // Polls the busy flag through the rw pin instead of waiting the worst-case duration after every transfer
+        void useBusyFlag(const bool enable = true);
+};
+
+
+
+// Several LCDs that share their data, rs & rw pins and only have their own enable pin. A 40x4 LCD counts as 2 displays, one per enable pin (lines 1-2 and 3-4).
+// Each display gets a transmit queue, and while one of them is executing a transaction the bus sends the next one to another
+class LCD_Bus {
+    private:
+        LCD_Setup **displays;
+        uint8_t number_of_displays;
+        uint8_t next_display{ 0 };
+        volatile bool isInUse{ false }; // set while any of the displays is sending, so that an interrupt can't drive the shared pins in the middle of a transfer
+
+    public:
+        // 'queues' must hold one queue per display; they're attached to the displays in the same order
+        LCD_Bus(LCD_Setup **bus_displays, LCD_TransmitQueue *queues, const uint8_t bus_number_of_displays);
+
+        // Gives every display a turn at the bus, starting after the display that went first last time
+        void service();
+
+        // Services the displays until all of their queues are empty
+        void flush();
 };
 
 
@@ -180,31 +648,102 @@ class LCD_Setup {
 
 template <typename STR_PTR_TYPE>
 void LCD_Setup::display_to_LCD(STR_PTR_TYPE *user_str) {
-    set_rs_and_rw(HIGH, LOW);
-
-    for (size_t i{ 0 }; user_str[i] != '\0'; i++) {
-        uint_fast8_t current_char_in_decimal{ (uint_fast8_t)user_str[i] };
-
-        translate_and_send_to_LCD(current_char_in_decimal);
-    }
+    write((const char *)user_str);
 }
 
 
 template <typename NUM_TYPE>
 void LCD_Setup::display_to_LCD(NUM_TYPE user_num) {
-    set_rs_and_rw(HIGH, LOW);
+    displayNumber(user_num);
+}
+
+
+template <typename INT_TYPE>
+void LCD_Setup::displayNumber(const INT_TYPE number, const uint8_t base, const uint8_t width, const bool zero_padding) {
+    typedef typename LCD_unsigned<INT_TYPE>::type UNSIGNED_TYPE;
+
+    // filled in from the right; 80 blocks fit any 64-bit number in binary along with its sign
+    char characters[LCD_DDRAM_size];
+    uint8_t first_character{ LCD_DDRAM_size };
+    const uint8_t field_width{ (uint8_t)(width > LCD_DDRAM_size ? LCD_DDRAM_size : width) };
+    const uint8_t digit_base{ (uint8_t)(base < 2 ? 2 : (base > 16 ? 16 : base)) }; // base 0 would divide by zero and base 1 would never finish
+
+    const bool isNegative{ LCD_is_negative(number) };
+    UNSIGNED_TYPE magnitude{ isNegative ? (UNSIGNED_TYPE)(0 - (UNSIGNED_TYPE)number) : (UNSIGNED_TYPE)number };
 
-    uint_fast8_t highest_power_of_10{ 0 };
-    NUM_TYPE temporary_copy{ user_num };
+    do {
+        const UNSIGNED_TYPE quotient{ (UNSIGNED_TYPE)(magnitude / digit_base) };
+        const uint8_t digit{ (uint8_t)(magnitude - quotient * digit_base) };
 
-    while (temporary_copy / 10 != 0) {
-        temporary_copy /= 10;
-        highest_power_of_10++;
+        characters[--first_character] = digit < 10 ? '0' + digit : 'A' + digit - 10;
+        magnitude = quotient;
+    } while (magnitude != 0);
+
+    if (zero_padding) {
+        while (LCD_DDRAM_size - first_character < field_width - isNegative) { characters[--first_character] = '0'; }
     }
-    for (int i{ highest_power_of_10 }; i > -1; i--) {
-        NUM_TYPE digit = ((NUM_TYPE)(user_num / pow(10, i))) % 10;
-        translate_and_send_to_LCD(digit + 48);
+
+    if (isNegative) { characters[--first_character] = '-'; }
+
+    while (LCD_DDRAM_size - first_character < field_width) { characters[--first_character] = ' '; }
+
+    display_characters(&characters[first_character], LCD_DDRAM_size - first_character);
+}
+
+
+template <typename INT_TYPE>
+void LCD_Setup::displayField(LCD_Field *field, const INT_TYPE number) {
+    typedef typename LCD_unsigned<INT_TYPE>::type UNSIGNED_TYPE;
+
+    const bool isNegative{ LCD_is_negative(number) };
+    UNSIGNED_TYPE magnitude{ isNegative ? (UNSIGNED_TYPE)(0 - (UNSIGNED_TYPE)number) : (UNSIGNED_TYPE)number };
+    uint8_t length{ 0 };
+
+    const uint8_t width{ start_field(field) };
+
+    // the LCD is in decrement mode, so the digits are written in the order the division produces them, without a buffer
+    do {
+        const UNSIGNED_TYPE quotient{ (UNSIGNED_TYPE)(magnitude / 10) };
+
+        write_field_character(length++, '0' + (uint8_t)(magnitude - quotient * 10));
+        magnitude = quotient;
+    } while (magnitude != 0 && length < width);
+
+    if (isNegative && length < width) { write_field_character(length++, '-'); }
+
+    end_field(field, length, width);
+}
+
+
+template <typename INT_TYPE>
+void LCD_Setup::displayFixed(const INT_TYPE number, const uint8_t fraction_bits, const uint8_t decimal_places) {
+    typedef typename LCD_unsigned<INT_TYPE>::type UNSIGNED_TYPE;
+
+    const bool isNegative{ LCD_is_negative(number) };
+    const UNSIGNED_TYPE magnitude{ isNegative ? (UNSIGNED_TYPE)(0 - (UNSIGNED_TYPE)number) : (UNSIGNED_TYPE)number };
+    const uint32_t scale{ power_of_10(decimal_places > 9 ? 9 : decimal_places) };
+    unsigned long long scaled_magnitude{ (unsigned long long)magnitude * scale };
+
+    // the fraction is scaled to decimal digits and rounded half up, which may carry into the integer part
+    if (fraction_bits != 0) {
+        const unsigned long long fraction_mask{ (1ULL << fraction_bits) - 1 };
+        const unsigned long long scaled_fraction{ (((unsigned long long)magnitude & fraction_mask) * scale + (1ULL << (fraction_bits - 1))) >> fraction_bits };
+
+        scaled_magnitude = ((unsigned long long)magnitude >> fraction_bits) * scale + scaled_fraction;
     }
+
+    display_scaled_number(isNegative && scaled_magnitude != 0, scaled_magnitude, decimal_places);
+}
+
+
+template <typename INT_TYPE>
+void LCD_Setup::displayScaled(const INT_TYPE number, const uint8_t decimal_places) {
+    typedef typename LCD_unsigned<INT_TYPE>::type UNSIGNED_TYPE;
+
+    const bool isNegative{ LCD_is_negative(number) };
+    const UNSIGNED_TYPE magnitude{ isNegative ? (UNSIGNED_TYPE)(0 - (UNSIGNED_TYPE)number) : (UNSIGNED_TYPE)number };
+
+    display_scaled_number(isNegative && magnitude != 0, magnitude, decimal_places);
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,178 @@
+#ifndef Arduino_h
+#define Arduino_h
+#pragma once
+
+// Just enough of the Arduino core for the library to build & run on the host (see hd44780_model.h)
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include "binary.h"
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(s))
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define pgm_read_word(p) (*(const uint16_t *)(p))
+
+class __FlashStringHelper;
+
+#include "hd44780_model.h"
+
+// Ports of an Uno: pins 0-7 are PORTD, 8-13 PORTB and 14-19 (A0-A5) PORTC
+#define NOT_A_PORT 0
+#define PB 2
+#define PC 3
+#define PD 4
+
+#define PORTB (mock().ports[PB])
+#define PORTC (mock().ports[PC])
+#define PORTD (mock().ports[PD])
+#define DDRB (mock().port_directions[PB])
+#define DDRC (mock().port_directions[PC])
+#define DDRD (mock().port_directions[PD])
+
+inline uint8_t digitalPinToPort(uint8_t pin) {
+    return pin < 8 ? PD : (pin < 14 ? PB : (pin < 20 ? PC : NOT_A_PORT));
+}
+
+inline uint8_t digitalPinToBitMask(uint8_t pin) {
+    return 1 << (pin < 8 ? pin : (pin < 14 ? pin - 8 : pin - 14));
+}
+
+inline volatile uint8_t *portOutputRegister(uint8_t port) {
+    return &mock().ports[port];
+}
+
+// A port register is plain memory, so what's written to it only reaches the pins when the library next restores SREG, waits, reads the clock
+// or writes a pin. The library writes the ports with interrupts off and restores SREG straight after, so no edge is missed.
+// 'port_writes' counts the writes that changed a pin
+inline void mock_sync_ports() {
+    MockBoard &board{ mock() };
+
+    for (uint8_t port{ PB }; port <= PD; port++) {
+        const uint8_t changed_bits{ (uint8_t)(board.ports[port] ^ board.port_levels[port]) };
+        if (changed_bits == 0) { continue; }
+
+        board.port_levels[port] = board.ports[port];
+        board.port_writes++;
+
+        for (uint8_t bit{ 0 }; bit < 8; bit++) {
+            if (!(changed_bits & (1 << bit))) { continue; }
+
+            const int pin{ port == PD ? bit : (port == PB ? 8 + bit : 14 + bit) };
+            mock_set_pin(pin, (board.ports[port] >> bit) & 1);
+        }
+
+        if (board.status_register & 0x80) { mock_interrupt(); }
+    }
+}
+
+// the status register; restoring it after 'cli' is when the library's port writes reach the pins
+struct MockStatusRegister {
+    operator uint8_t() const { return mock().status_register; }
+
+    MockStatusRegister &operator=(const uint8_t value) {
+        mock().status_register = value;
+        mock_sync_ports();
+        return *this;
+    }
+};
+
+#define SREG (MockStatusRegister())
+
+inline void cli() {
+    mock().status_register &= 0x7F;
+}
+
+// like on an AVR, the port bit of an input turns its pull-up on, and an output drives whatever its port bit is
+inline void pinMode(uint8_t pin, uint8_t mode) {
+    mock_sync_ports();
+
+    mock().pin_mode_calls++;
+    mock().pin_modes[pin] = mode;
+
+    const uint8_t port{ digitalPinToPort(pin) };
+    if (port == NOT_A_PORT) { return; }
+
+    const uint8_t bit_mask{ digitalPinToBitMask(pin) };
+
+    if (mode == OUTPUT) {
+        mock().port_directions[port] |= bit_mask;
+        mock_set_pin(pin, mock().ports[port] & bit_mask);
+        return;
+    }
+
+    mock().port_directions[port] &= ~bit_mask;
+
+    if (mode == INPUT_PULLUP) { mock().ports[port] |= bit_mask; }
+    else { mock().ports[port] &= ~bit_mask; }
+
+    mock().port_levels[port] = mock().ports[port];
+}
+
+// digitalWrite changes the pin's bit in its port too, like the real one, so that a later read-modify-write of the port keeps it
+inline void digitalWrite(uint8_t pin, uint8_t level) {
+    mock_sync_ports();
+
+    mock().gpio_writes++;
+    mock().clock += mock().gpio_write_time;
+
+    const uint8_t port{ digitalPinToPort(pin) };
+
+    if (port != NOT_A_PORT) {
+        if (level) { mock().ports[port] |= digitalPinToBitMask(pin); }
+        else { mock().ports[port] &= ~digitalPinToBitMask(pin); }
+
+        mock().port_levels[port] = mock().ports[port];
+    }
+
+    mock_set_pin(pin, level);
+    mock_interrupt();
+}
+
+// an input that nothing drives reads low, unless its pull-up is on
+inline int digitalRead(uint8_t pin) {
+    if (mock().isDrivenByLCD[pin]) { return mock().pins[pin]; }
+    if (mock().pin_modes[pin] == INPUT_PULLUP) { return HIGH; }
+    if (mock().pin_modes[pin] == INPUT) { return LOW; }
+
+    return mock().pins[pin];
+}
+
+inline void delayMicroseconds(unsigned int us) {
+    mock_sync_ports();
+    mock().clock += us;
+}
+
+inline void delay(unsigned long ms) {
+    mock().clock += ms * 1000;
+}
+
+inline unsigned long micros() {
+    mock_sync_ports();
+
+    const unsigned long now{ mock().clock };
+    mock().clock += mock().micros_time;
+
+    return now;
+}
+
+inline unsigned long millis() {
+    return mock().clock / 1000;
+}
+
+#include "WString.h"
+#include "Print.h"
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef Print_h
+#define Print_h
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// Arduino's Print class, with the overloads the tests use
+class Print {
+    public:
+        virtual ~Print() {}
+
+        virtual size_t write(uint8_t character) = 0;
+
+        virtual size_t write(const uint8_t *buffer, size_t size) {
+            size_t written{ 0 };
+            while (size-- && write(*buffer++)) { written++; }
+
+            return written;
+        }
+
+        size_t write(const char *str) {
+            return str == nullptr ? 0 : write((const uint8_t *)str, strlen(str));
+        }
+
+        size_t write(const char *buffer, size_t size) {
+            return write((const uint8_t *)buffer, size);
+        }
+
+        virtual void flush() {}
+
+        size_t print(const char *str) { return write(str); }
+        size_t print(char character) { return write((uint8_t)character); }
+        size_t print(int number) { return print_formatted("%d", number); }
+        size_t print(unsigned int number) { return print_formatted("%u", number); }
+        size_t print(long number) { return print_formatted("%ld", number); }
+        size_t print(unsigned long number) { return print_formatted("%lu", number); }
+
+        size_t print(double number, int digits = 2) {
+            char characters[32];
+            snprintf(characters, sizeof(characters), "%.*f", digits, number);
+
+            return write(characters);
+        }
+
+        size_t println() { return write("\r\n"); }
+
+        template <typename VALUE_TYPE>
+        size_t println(const VALUE_TYPE value) {
+            const size_t written{ print(value) };
+            return written + println();
+        }
+
+    private:
+        template <typename NUM_TYPE>
+        size_t print_formatted(const char *format, const NUM_TYPE number) {
+            char characters[24];
+            snprintf(characters, sizeof(characters), format, number);
+
+            return write(characters);
+        }
+};
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef String_class_h
+#define String_class_h
+#pragma once
+
+#include <string>
+
+// Arduino's String, backed by std::string
+class String {
+    private:
+        std::string text;
+
+    public:
+        String(const char *characters = "") : text(characters) {}
+
+        const char *c_str() const { return text.c_str(); }
+        unsigned int length() const { return text.size(); }
+};
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef TwoWire_h
+#define TwoWire_h
+#pragma once
+
+#include "Arduino.h"
+
+#define BUFFER_LENGTH 32
+
+// A PCF8574 backpack on the I2C bus (P0 = rs, P1 = rw, P2 = enable, P3 = backlight, P4-P7 = DB4-DB7). Bytes take 23 microseconds each at 400 kHz
+class TwoWire {
+    private:
+        uint8_t buffered_bytes{ 0 };
+
+    public:
+        HD44780Model *backpack{ nullptr };
+        uint8_t address{ 0 };
+        bool isBacklightOn{ false };
+
+        unsigned long transmissions{ 0 };
+        unsigned long bytes{ 0 };
+        unsigned long dropped_bytes{ 0 }; // bytes that didn't fit in the buffer
+
+        void begin() {}
+
+        void setClock(uint32_t) {}
+
+        void beginTransmission(uint8_t device_address) {
+            address = device_address;
+            buffered_bytes = 0;
+            transmissions++;
+            mock().clock += 25; // start condition & address
+        }
+
+        size_t write(uint8_t value) {
+            if (buffered_bytes == BUFFER_LENGTH) {
+                dropped_bytes++;
+                return 0;
+            }
+
+            buffered_bytes++;
+            bytes++;
+            mock().clock += 23;
+
+            HD44780Model &controller{ *backpack };
+
+            for (int bit{ 4 }; bit < 8; bit++) { mock_set_pin(controller.data_pins[bit], (value >> bit) & 1); }
+            mock_set_pin(controller.rs_pin, value & 1);
+            mock_set_pin(controller.rw_pin, (value >> 1) & 1);
+            isBacklightOn = (value >> 3) & 1;
+            mock_set_pin(controller.en_pin, (value >> 2) & 1);
+
+            return 1;
+        }
+
+        size_t write(const uint8_t *values, size_t count) {
+            size_t written{ 0 };
+            while (written < count && write(values[written])) { written++; }
+
+            return written;
+        }
+
+        uint8_t endTransmission() {
+            mock().clock += 3;
+            return 0;
+        }
+};
+
+static TwoWire Wire;
+
+#endif
@@ -0,0 +1,445 @@
+#ifndef HD44780_MODEL_H
+#define HD44780_MODEL_H
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+/*
+
+Host-side stand-ins for the Arduino pins and an HD44780 controller, used by the native tests (pio test -e native).
+
+- every pin is a slot in 'mock().pins'; digitalWrite sets it and moves the virtual clock by 'gpio_write_time'
+- a controller watches its enable pin and executes what's on its rs & data pins on the falling edge, like the real one (pg 49 of the datasheet)
+- an instruction that arrives while the controller is still busy with the previous one is counted in 'violations' instead of being dropped, so that
+  the tests can both check the screen and check that the library waited long enough
+- time only moves when the library waits (delayMicroseconds), reads the clock (micros) or writes a pin
+
+*/
+
+struct HD44780Model {
+    // pins the controller is wired to; -1 = not connected (e.g. rw tied to ground)
+    int rs_pin{ -1 };
+    int rw_pin{ -1 };
+    int en_pin{ -1 };
+    int data_pins[8]{ -1, -1, -1, -1, -1, -1, -1, -1 }; // DB0 -> DB7
+
+    // execution times in microseconds (HD44780 at 270 kHz by default)
+    unsigned long command_time{ 37 };
+    unsigned long data_write_time{ 37 };
+    unsigned long clear_and_home_time{ 1520 };
+    unsigned long first_function_set_time{ 4100 };
+    unsigned long second_function_set_time{ 100 };
+    unsigned long power_rise_time{ 40000 };
+
+    // controller state
+    bool isEightBitMode{ true };
+    bool hasTwoLines{ false };
+    bool hasLargeFont{ false };
+    bool isDisplayOn{ false };
+    bool isCursorOn{ false };
+    bool isBlinking{ false };
+    bool incrementsAddress{ true };
+    bool shiftsOnWrite{ false };
+    bool addressesCGRAM{ false };
+    bool hasUpperNibble{ false };
+    bool readsLowerNibble{ false };
+    uint8_t upper_nibble{ 0 };
+    int address_counter{ 0 };
+    int display_shift{ 0 }; // positive when the content has moved right
+    uint8_t function_sets{ 0 };
+    uint8_t ddram[128];
+    uint8_t cgram[64];
+
+    bool answersReads{ true }; // false for modules that never drive the data pins, so they float while rw is high
+
+    unsigned long power_on_time{ 0 };
+    unsigned long busy_until{ 0 };
+
+    // counters
+    unsigned long transactions{ 0 };
+    unsigned long data_writes{ 0 };
+    unsigned long command_writes{ 0 };
+    unsigned long busy_flag_reads{ 0 };
+    unsigned long violations{ 0 };
+
+    HD44780Model() {
+        memset(ddram, ' ', sizeof(ddram));
+        memset(cgram, 0, sizeof(cgram));
+    }
+
+    void useFourBitPins(const int rs, const int rw, const int en, const int db7, const int db6, const int db5, const int db4) {
+        rs_pin = rs;
+        rw_pin = rw;
+        en_pin = en;
+        data_pins[7] = db7;
+        data_pins[6] = db6;
+        data_pins[5] = db5;
+        data_pins[4] = db4;
+    }
+
+    void useEightBitPins(const int rs, const int rw, const int en, const int db7, const int db6, const int db5, const int db4, const int db3, const int db2, const int db1, const int db0) {
+        useFourBitPins(rs, rw, en, db7, db6, db5, db4);
+        data_pins[3] = db3;
+        data_pins[2] = db2;
+        data_pins[1] = db1;
+        data_pins[0] = db0;
+    }
+
+    bool isBusy(const unsigned long now) const {
+        return now < busy_until;
+    }
+
+    // what the LCD shows on a line, 'width' blocks from the left edge of the screen
+    std::string line(const uint8_t display_line, const uint8_t width = 16) const {
+        const int line_length{ hasTwoLines ? 40 : 80 };
+        const int base{ hasTwoLines && display_line == 2 ? 0x40 : 0 };
+        std::string text;
+
+        for (int i{ 0 }; i < width; i++) {
+            const int column{ ((i - display_shift) % line_length + line_length) % line_length };
+            const uint8_t c{ ddram[base + column] };
+
+            text += c < 32 || c > 126 ? '?' : (char)c;
+        }
+
+        return text;
+    }
+
+    // a whole line of the DDRAM, visible or not
+    std::string DDRAM_line(const uint8_t display_line) const {
+        const int line_length{ hasTwoLines ? 40 : 80 };
+        const int base{ hasTwoLines && display_line == 2 ? 0x40 : 0 };
+
+        return std::string((const char *)&ddram[base], line_length);
+    }
+
+    // the CGRAM rows a character code shows, or nullptr for the font's own characters. Codes 0-15 are the custom ones; with the 5x10 font,
+    // bits 1-2 pick one of 4 slots of 16 rows (pg 19-20 of the datasheet)
+    const uint8_t *glyph(const uint8_t code) const {
+        if (code > 15) { return nullptr; }
+
+        return hasLargeFont && !hasTwoLines ? &cgram[((code >> 1) & 3) * 16] : &cgram[(code & 7) * 8];
+    }
+
+    // an 8-bit transfer, or one half of a 4-bit one
+    void latch(const uint8_t bits, const bool rs, const unsigned long now) {
+        if (isEightBitMode) {
+            execute(bits, rs, now);
+            return;
+        }
+
+        if (!hasUpperNibble) {
+            upper_nibble = bits & 0xF0;
+            hasUpperNibble = true;
+            return;
+        }
+
+        hasUpperNibble = false;
+        execute(upper_nibble | (bits >> 4), rs, now);
+    }
+
+    // busy flag & address counter, or the half of it that's being read in 4-bit mode
+    uint8_t read(const unsigned long now) {
+        busy_flag_reads++;
+
+        const uint8_t value{ (uint8_t)((isBusy(now) ? 0x80 : 0) | (address_counter & 0x7F)) };
+        if (isEightBitMode) { return value; }
+
+        readsLowerNibble = !readsLowerNibble;
+        return readsLowerNibble ? value : (uint8_t)(value << 4);
+    }
+
+    void execute(const uint8_t value, const bool rs, const unsigned long now) {
+        transactions++;
+
+        if (isBusy(now) || now < power_on_time + power_rise_time) { violations++; }
+
+        unsigned long execution_time{ command_time };
+
+        if (rs) {
+            data_writes++;
+            execution_time = data_write_time;
+            write_data(value);
+        }
+        else {
+            command_writes++;
+
+            if (value & 0x80) {
+                address_counter = value & 0x7F;
+                addressesCGRAM = false;
+            }
+            else if (value & 0x40) {
+                address_counter = value & 0x3F;
+                addressesCGRAM = true;
+            }
+            else if (value & 0x20) {
+                // the first 2 function sets after power on are the reset sequence of the initialization by instruction (pg 45-46 of the datasheet)
+                if (function_sets == 0) { execution_time = first_function_set_time; }
+                else if (function_sets == 1) { execution_time = second_function_set_time; }
+                if (function_sets < 255) { function_sets++; }
+
+                isEightBitMode = value & 0x10;
+                hasUpperNibble = false;
+                hasTwoLines = value & 0x08;
+                hasLargeFont = value & 0x04;
+            }
+            else if (value & 0x10) {
+                const int direction{ (value & 0x04) ? 1 : -1 };
+
+                if (value & 0x08) { display_shift += direction; }
+                else { move_address_counter(direction); }
+            }
+            else if (value & 0x08) {
+                isDisplayOn = value & 0x04;
+                isCursorOn = value & 0x02;
+                isBlinking = value & 0x01;
+            }
+            else if (value & 0x04) {
+                incrementsAddress = value & 0x02;
+                shiftsOnWrite = value & 0x01;
+            }
+            else if (value & 0x02) {
+                address_counter = 0;
+                display_shift = 0;
+                addressesCGRAM = false;
+                execution_time = clear_and_home_time;
+            }
+            else if (value & 0x01) {
+                memset(ddram, ' ', sizeof(ddram));
+                address_counter = 0;
+                display_shift = 0;
+                incrementsAddress = true;
+                addressesCGRAM = false;
+                execution_time = clear_and_home_time;
+            }
+        }
+
+        busy_until = now + execution_time;
+    }
+
+    private:
+        void write_data(const uint8_t value) {
+            if (addressesCGRAM) {
+                cgram[address_counter & 0x3F] = value;
+                address_counter = (address_counter + (incrementsAddress ? 1 : -1)) & 0x3F;
+                return;
+            }
+
+            ddram[address_counter & 0x7F] = value;
+            move_address_counter(incrementsAddress ? 1 : -1);
+        }
+
+        // the lines are rings of 40 blocks (0x00-0x27 & 0x40-0x67), or one of 80 (0x00-0x4F); the address goes from the end of one line to the start of the other
+        void move_address_counter(const int direction) {
+            address_counter += direction;
+
+            if (hasTwoLines) {
+                if (address_counter == 0x28) { address_counter = 0x40; }
+                else if (address_counter == 0x68) { address_counter = 0x00; }
+                else if (address_counter == 0x3F) { address_counter = 0x27; }
+                else if (address_counter == -1) { address_counter = 0x67; }
+            }
+            else {
+                if (address_counter == 0x50) { address_counter = 0x00; }
+                else if (address_counter == -1) { address_counter = 0x4F; }
+            }
+        }
+};
+
+
+
+// How the outputs of an 8-bit shift register (or an I2C backpack) are wired to a controller (see 'mock_SR_write' & 'mock_SR_send_buffer')
+struct MockShiftRegister {
+    HD44780Model *controller{ nullptr };
+    bool isMSB{ true }; // MSB: bit 0 drives DB7; LSB: bit 7 drives DB7
+    bool isEightBit{ false };
+    int rs_bit{ -1 }; // only when rs & en are on the register too
+    int en_bit{ -1 };
+    unsigned long frame_time{ 0 }; // time it takes to shift a byte in
+
+    unsigned long calls{ 0 };
+    unsigned long frames{ 0 };
+};
+
+struct MockBoard {
+    static const int pin_count{ 256 };
+
+    unsigned long clock{ 0 };
+    unsigned long gpio_write_time{ 0 }; // microseconds each digitalWrite takes
+    unsigned long micros_time{ 1 }; // microseconds each micros() call takes, so that polling loops always move on
+
+    uint8_t pins[pin_count];
+    uint8_t pin_modes[pin_count];
+    bool isDrivenByLCD[pin_count];
+
+    HD44780Model *controllers[4];
+    uint8_t controller_count{ 0 };
+
+    MockShiftRegister shift_register;
+
+    // an Uno's port registers (index PB, PC or PD), for builds with 'LCD_port_registers' (see Arduino.h)
+    static const int port_count{ 5 };
+    uint8_t ports[port_count];
+    uint8_t port_directions[port_count];
+    uint8_t port_levels[port_count]; // what the pins were last set to, so that port writes can be told apart
+    uint8_t status_register{ 0x80 };
+
+    unsigned long gpio_writes{ 0 };
+    unsigned long port_writes{ 0 };
+    unsigned long pin_mode_calls{ 0 };
+
+    // runs after every digitalWrite & shift register frame, like a timer interrupt that can fire at any point of a transfer
+    void (*interrupt_handler)(){ nullptr };
+    bool isInInterrupt{ false };
+};
+
+inline MockBoard &mock() {
+    static MockBoard board;
+    return board;
+}
+
+// runs the interrupt handler, unless it's the one writing the pin
+inline void mock_interrupt() {
+    MockBoard &board{ mock() };
+    if (board.interrupt_handler == nullptr || board.isInInterrupt) { return; }
+
+    board.isInInterrupt = true;
+    board.interrupt_handler();
+    board.isInInterrupt = false;
+}
+
+// Starts every test from a board with no controllers, all pins low and the clock at 0
+inline void mock_reset() {
+    MockBoard &board{ mock() };
+
+    board.clock = 0;
+    board.gpio_write_time = 0;
+    board.micros_time = 1;
+    board.controller_count = 0;
+    board.shift_register = MockShiftRegister();
+    board.gpio_writes = 0;
+    board.port_writes = 0;
+    board.pin_mode_calls = 0;
+    board.status_register = 0x80;
+    board.interrupt_handler = nullptr;
+    board.isInInterrupt = false;
+
+    memset(board.pins, 0, sizeof(board.pins));
+    memset(board.pin_modes, 0, sizeof(board.pin_modes));
+    memset(board.isDrivenByLCD, 0, sizeof(board.isDrivenByLCD));
+    memset(board.ports, 0, sizeof(board.ports));
+    memset(board.port_directions, 0, sizeof(board.port_directions));
+    memset(board.port_levels, 0, sizeof(board.port_levels));
+}
+
+// attaching a controller again (e.g. after rewiring it) only restarts its power on time
+inline void mock_attach(HD44780Model *controller) {
+    MockBoard &board{ mock() };
+    controller->power_on_time = board.clock;
+
+    for (uint8_t i{ 0 }; i < board.controller_count; i++) {
+        if (board.controllers[i] == controller) { return; }
+    }
+
+    board.controllers[board.controller_count++] = controller;
+}
+
+inline unsigned long mock_violations() {
+    unsigned long violations{ 0 };
+
+    for (uint8_t i{ 0 }; i < mock().controller_count; i++) {
+        violations += mock().controllers[i]->violations;
+    }
+
+    return violations;
+}
+
+// Changes a pin's level the way the LCD would see it, whether the Arduino, a shift register or a backpack drives it
+inline void mock_set_pin(const int pin, const uint8_t level) {
+    MockBoard &board{ mock() };
+    if (pin < 0 || pin >= MockBoard::pin_count) { return; }
+
+    const uint8_t previous_level{ board.pins[pin] };
+    board.pins[pin] = level ? 1 : 0;
+
+    for (uint8_t i{ 0 }; i < board.controller_count; i++) {
+        HD44780Model &controller{ *board.controllers[i] };
+        const bool isReading{ controller.rw_pin >= 0 && board.pins[controller.rw_pin] };
+
+        // the controller lets go of the data pins once rw goes back low
+        if (pin == controller.rw_pin && !board.pins[pin]) {
+            for (int bit{ 0 }; bit < 8; bit++) {
+                if (controller.data_pins[bit] >= 0) { board.isDrivenByLCD[controller.data_pins[bit]] = false; }
+            }
+        }
+
+        if (pin != controller.en_pin || previous_level == board.pins[pin]) { continue; }
+
+        if (board.pins[pin] && isReading) {
+            if (!controller.answersReads) { continue; }
+
+            const uint8_t value{ controller.read(board.clock) };
+
+            for (int bit{ 0 }; bit < 8; bit++) {
+                const int data_pin{ controller.data_pins[bit] };
+
+                if (data_pin >= 0) {
+                    board.isDrivenByLCD[data_pin] = true;
+                    board.pins[data_pin] = (value >> bit) & 1;
+                }
+            }
+        }
+        else if (!board.pins[pin] && !isReading) {
+            uint8_t value{ 0 };
+
+            for (int bit{ 0 }; bit < 8; bit++) {
+                const int data_pin{ controller.data_pins[bit] };
+                if (data_pin >= 0 && board.pins[data_pin]) { value |= 1 << bit; }
+            }
+
+            controller.latch(value, controller.rs_pin >= 0 && board.pins[controller.rs_pin], board.clock);
+        }
+    }
+}
+
+// A byte written to the shift register's outputs; the data bits follow 'isMSB', rs & en are only decoded when their bits are set
+inline void mock_apply_SR_byte(const uint8_t bits) {
+    MockShiftRegister &shift_register{ mock().shift_register };
+    HD44780Model *controller{ shift_register.controller };
+
+    mock().clock += shift_register.frame_time;
+    shift_register.frames++;
+
+    for (int bit{ 0 }; bit < 8; bit++) {
+        if (bit == shift_register.rs_bit || bit == shift_register.en_bit) { continue; }
+
+        int data_bit{ shift_register.isMSB ? 7 - bit : bit };
+        if (!shift_register.isEightBit && data_bit < 4) { continue; }
+
+        mock_set_pin(controller->data_pins[data_bit], (bits >> bit) & 1);
+    }
+
+    if (shift_register.rs_bit >= 0) { mock_set_pin(controller->rs_pin, (bits >> shift_register.rs_bit) & 1); }
+    if (shift_register.en_bit >= 0) { mock_set_pin(controller->en_pin, (bits >> shift_register.en_bit) & 1); }
+
+    mock_interrupt();
+}
+
+// Stand-in for the sketch's shift register function (data pins only on the register)
+inline void mock_SR_write(uint8_t bits) {
+    mock().shift_register.calls++;
+    mock_apply_SR_byte(bits);
+}
+
+// Stand-in for the sketch's buffered shift register function (rs & en on the register too)
+inline void mock_SR_send_buffer(const uint8_t *bytes, const size_t count) {
+    mock().shift_register.calls++;
+
+    for (size_t i{ 0 }; i < count; i++) {
+        mock_apply_SR_byte(bytes[i]);
+    }
+}
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef TEST_LCD_H
+#define TEST_LCD_H
+#pragma once
+
+#include <Arduino.h>
+#include <unity.h>
+#include <stdio.h>
+#include <string>
+
+// The wiring most tests use: the pins of documentation/example.cpp, with DB3-DB0 on 9-6 for 8-bit mode
+#define TEST_RS_PIN 12
+#define TEST_RW_PIN 11
+#define TEST_EN_PIN 10
+#define TEST_DB7_PIN 5
+#define TEST_DB6_PIN 4
+#define TEST_DB5_PIN 3
+#define TEST_DB4_PIN 2
+#define TEST_DB3_PIN 9
+#define TEST_DB2_PIN 8
+#define TEST_DB1_PIN 7
+#define TEST_DB0_PIN 6
+
+// constructor arguments for a 16x2 LCD in 4-bit mode on the pins above
+#define TEST_4_BIT_LCD TEST_RS_PIN, TEST_RW_PIN, TEST_EN_PIN, 4, true, false, TEST_DB7_PIN, TEST_DB6_PIN, TEST_DB5_PIN, TEST_DB4_PIN
+
+// pins of the controller behind a shift register or backpack, which the Arduino never touches
+#define TEST_SR_RS_PIN 100
+#define TEST_SR_EN_PIN 101
+#define TEST_SR_RW_PIN 102
+#define TEST_SR_DB7_PIN 117
+
+inline void attach_test_controller(HD44780Model &controller, const bool isEightBit = false) {
+    controller = HD44780Model();
+
+    if (isEightBit) {
+        controller.useEightBitPins(TEST_RS_PIN, TEST_RW_PIN, TEST_EN_PIN, TEST_DB7_PIN, TEST_DB6_PIN, TEST_DB5_PIN, TEST_DB4_PIN, TEST_DB3_PIN, TEST_DB2_PIN, TEST_DB1_PIN, TEST_DB0_PIN);
+    }
+    else {
+        controller.useFourBitPins(TEST_RS_PIN, TEST_RW_PIN, TEST_EN_PIN, TEST_DB7_PIN, TEST_DB6_PIN, TEST_DB5_PIN, TEST_DB4_PIN);
+    }
+
+    mock_attach(&controller);
+}
+
+// for controllers behind a shift register or I2C backpack (rw is only wired on the backpack)
+inline void attach_SR_controller(HD44780Model &controller, const bool hasRwPin = false) {
+    controller = HD44780Model();
+    controller.useEightBitPins(TEST_SR_RS_PIN, hasRwPin ? TEST_SR_RW_PIN : -1, TEST_SR_EN_PIN, TEST_SR_DB7_PIN, TEST_SR_DB7_PIN - 1, TEST_SR_DB7_PIN - 2, TEST_SR_DB7_PIN - 3, TEST_SR_DB7_PIN - 4, TEST_SR_DB7_PIN - 5, TEST_SR_DB7_PIN - 6, TEST_SR_DB7_PIN - 7);
+    mock_attach(&controller);
+
+    mock().shift_register.controller = &controller;
+}
+
+// the first 'length' blocks of a line in the DDRAM, visible or not
+inline std::string DDRAM_text(const HD44780Model &controller, const uint8_t display_line, const size_t length) {
+    return controller.DDRAM_line(display_line).substr(0, length);
+}
+
+// prints a benchmark result with the simulated time & the number of instructions the LCD received
+inline void report(const char *scenario, const unsigned long transactions, const unsigned long microseconds) {
+    char message[120];
+    snprintf(message, sizeof(message), "%s: %lu transactions, %lu us", scenario, transactions, microseconds);
+
+    TEST_MESSAGE(message);
+}
+
+#endif
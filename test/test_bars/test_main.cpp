@@ -0,0 +1,82 @@
+#include <test_lcd.h>
+#include <arduino_lcdpp.h>
+
+// Bars & sparklines (see 'setupBar'): partial-fill glyphs go through the glyph cache, and only the blocks whose fill changed are rewritten
+
+HD44780Model controller;
+LCD_GlyphCache glyph_cache;
+
+void setUp() {
+    mock_reset();
+    attach_test_controller(controller);
+}
+
+void tearDown() {}
+
+
+void test_horizontal_bar() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.useGlyphCache(&glyph_cache);
+
+    LCD_Bar bar;
+    lcd.setupBar(&bar, 2, 1, 4);
+    lcd.drawBar(&bar, 12);
+
+    TEST_ASSERT_EQUAL(LCD_full_block_character, controller.ddram[0x40]);
+    TEST_ASSERT_EQUAL(LCD_full_block_character, controller.ddram[0x41]);
+    TEST_ASSERT_EQUAL(' ', controller.ddram[0x43]);
+    TEST_ASSERT_EQUAL(B11000, controller.glyph(controller.ddram[0x42])[0]);
+
+    // moving the level within the same block only rewrites that block
+    const unsigned long start_data_writes{ controller.data_writes };
+    lcd.drawBar(&bar, 13);
+
+    TEST_ASSERT_EQUAL(1 + 8, controller.data_writes - start_data_writes);
+    TEST_ASSERT_EQUAL(B11100, controller.glyph(controller.ddram[0x42])[0]);
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_sparkline() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.useGlyphCache(&glyph_cache);
+
+    const uint8_t levels[4]{ 0, 4, 8, 4 };
+    lcd.drawSparkline(1, 5, levels, 4);
+
+    TEST_ASSERT_EQUAL(' ', controller.ddram[4]);
+    TEST_ASSERT_EQUAL(LCD_full_block_character, controller.ddram[6]);
+    TEST_ASSERT_EQUAL(controller.ddram[5], controller.ddram[7]);
+    TEST_ASSERT_EQUAL(B00000, controller.glyph(controller.ddram[5])[3]);
+    TEST_ASSERT_EQUAL(B11111, controller.glyph(controller.ddram[5])[4]);
+}
+
+
+// the 5x10 font has 10 levels per block, and its glyphs are in slots 2 codes apart
+void test_vertical_bar_5x10() {
+    LCD_Setup lcd(TEST_RS_PIN, TEST_RW_PIN, TEST_EN_PIN, 4, false, true, TEST_DB7_PIN, TEST_DB6_PIN, TEST_DB5_PIN, TEST_DB4_PIN);
+    lcd.useGlyphCache(&glyph_cache);
+
+    LCD_Bar bar;
+    lcd.setupBar(&bar, 1, 1, 1, true);
+    lcd.drawBar(&bar, 4);
+    lcd.drawBar(&bar, 7);
+
+    const uint8_t *rows{ controller.glyph(controller.ddram[0]) };
+
+    TEST_ASSERT_TRUE(rows != nullptr);
+    TEST_ASSERT_EQUAL(B00000, rows[2]);
+    TEST_ASSERT_EQUAL(B11111, rows[3]);
+    TEST_ASSERT_EQUAL(B11111, rows[9]);
+    TEST_ASSERT_EQUAL(B00000, rows[10]);
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_horizontal_bar);
+    RUN_TEST(test_sparkline);
+    RUN_TEST(test_vertical_bar_5x10);
+    return UNITY_END();
+}
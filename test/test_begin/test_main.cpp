@@ -0,0 +1,87 @@
+#include <test_lcd.h>
+#include <arduino_lcdpp.h>
+
+// Initialization (see 'begin'): the power rise wait depends on how long the board has been running
+
+HD44780Model controller;
+
+void setUp() {
+    mock_reset();
+    attach_test_controller(controller);
+}
+
+void tearDown() {}
+
+
+void test_constructor_waits_for_the_power_to_rise() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+
+    TEST_ASSERT_GREATER_OR_EQUAL(LCD_HD44780_timing.power_rise, mock().clock);
+    TEST_ASSERT_TRUE(controller.isDisplayOn);
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_no_wait_once_the_board_has_been_running() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+
+    const unsigned long start_time{ mock().clock };
+    lcd.begin();
+
+    TEST_ASSERT_LESS_THAN(LCD_HD44780_timing.power_rise, mock().clock - start_time);
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_LCD_switched_on_later() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+
+    attach_test_controller(controller);
+    lcd.begin(LCD_wait_for_power_rise);
+    lcd.display("on");
+
+    TEST_ASSERT_EQUAL_STRING("on              ", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_begin_later_leaves_the_LCD_alone() {
+    LCD_Setup lcd(LCD_begin_later, TEST_4_BIT_LCD);
+
+    TEST_ASSERT_EQUAL(0, controller.transactions);
+    TEST_ASSERT_EQUAL(0, mock().gpio_writes);
+
+    lcd.useBusyFlag();
+    lcd.begin(LCD_wait_for_power_rise);
+    lcd.display("later");
+
+    TEST_ASSERT_EQUAL_STRING("later           ", controller.line(1).c_str());
+    TEST_ASSERT_GREATER_THAN(0, controller.busy_flag_reads);
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_begin_again_resets_the_LCD() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.moveCursor(2, 5);
+    lcd.moveDisplayLeft(3);
+    lcd.display("old");
+
+    lcd.begin(LCD_power_is_stable);
+    lcd.display("new");
+
+    TEST_ASSERT_EQUAL_STRING("new             ", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL_STRING("                ", controller.line(2).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_constructor_waits_for_the_power_to_rise);
+    RUN_TEST(test_no_wait_once_the_board_has_been_running);
+    RUN_TEST(test_LCD_switched_on_later);
+    RUN_TEST(test_begin_later_leaves_the_LCD_alone);
+    RUN_TEST(test_begin_again_resets_the_LCD);
+    return UNITY_END();
+}
@@ -0,0 +1,88 @@
+#include <test_lcd.h>
+#include <arduino_lcdpp.h>
+
+// Benchmark scenarios: run with 'pio test -e native -v' to see the simulated time & instruction count of each
+
+HD44780Model controller;
+
+void setUp() {
+    mock_reset();
+    attach_test_controller(controller);
+}
+
+void tearDown() {}
+
+
+void test_init() {
+    LCD_Setup lcd(TEST_RS_PIN, TEST_RW_PIN, TEST_EN_PIN, 4, true, false, TEST_DB7_PIN, TEST_DB6_PIN, TEST_DB5_PIN, TEST_DB4_PIN);
+    report("init (power rise included)", controller.transactions, mock().clock);
+
+    const unsigned long start_transactions{ controller.transactions };
+    const unsigned long start_time{ mock().clock };
+    lcd.begin(LCD_power_is_stable);
+    report("init (power already stable)", controller.transactions - start_transactions, mock().clock - start_time);
+
+    TEST_ASSERT_TRUE(controller.isDisplayOn);
+    TEST_ASSERT_TRUE(controller.hasTwoLines);
+    TEST_ASSERT_FALSE(controller.isEightBitMode);
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_full_refresh() {
+    LCD_Setup lcd(TEST_RS_PIN, TEST_RW_PIN, TEST_EN_PIN, 4, true, false, TEST_DB7_PIN, TEST_DB6_PIN, TEST_DB5_PIN, TEST_DB4_PIN);
+    const unsigned long start_transactions{ controller.transactions };
+    const unsigned long start_time{ mock().clock };
+
+    lcd.clearDisplay();
+    lcd.display("Temp:   21.50 C ");
+    lcd.moveCursor(2, 1);
+    lcd.display("Humidity: 40.2 %");
+
+    report("full 16x2 refresh", controller.transactions - start_transactions, mock().clock - start_time);
+
+    TEST_ASSERT_EQUAL_STRING("Temp:   21.50 C ", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL_STRING("Humidity: 40.2 %", controller.line(2).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_number_formatting() {
+    LCD_Setup lcd(TEST_RS_PIN, TEST_RW_PIN, TEST_EN_PIN, 4, true, false, TEST_DB7_PIN, TEST_DB6_PIN, TEST_DB5_PIN, TEST_DB4_PIN);
+    const unsigned long start_transactions{ controller.transactions };
+    const unsigned long start_time{ mock().clock };
+
+    lcd.display(-1234567L, ' ', 3.14159, ' ', 0xBEEFu);
+
+    report("number formatting", controller.transactions - start_transactions, mock().clock - start_time);
+
+    TEST_ASSERT_EQUAL_STRING("-1234567 3.14 48", DDRAM_text(controller, 1, 16).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_cursor_moves() {
+    LCD_Setup lcd(TEST_RS_PIN, TEST_RW_PIN, TEST_EN_PIN, 4, true, false, TEST_DB7_PIN, TEST_DB6_PIN, TEST_DB5_PIN, TEST_DB4_PIN);
+    const unsigned long start_transactions{ controller.transactions };
+    const unsigned long start_time{ mock().clock };
+
+    for (uint8_t block{ 1 }; block <= 40; block++) {
+        lcd.moveCursor(block % 2 + 1, block);
+    }
+
+    report("40 cursor moves", controller.transactions - start_transactions, mock().clock - start_time);
+
+    TEST_ASSERT_EQUAL(40, controller.transactions - start_transactions);
+    TEST_ASSERT_EQUAL(0x27, controller.address_counter);
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_init);
+    RUN_TEST(test_full_refresh);
+    RUN_TEST(test_number_formatting);
+    RUN_TEST(test_cursor_moves);
+    return UNITY_END();
+}
@@ -0,0 +1,135 @@
+#include <test_lcd.h>
+#include <arduino_lcdpp.h>
+
+// Shared bus (see 'LCD_Bus'): displays share the data, rs & rw pins and each has its own enable pin
+
+#define TEST_SECOND_EN_PIN 13
+#define TEST_THIRD_EN_PIN 14
+
+HD44780Model controllers[3];
+
+void setUp() {
+    mock_reset();
+
+    const uint8_t en_pins[3]{ TEST_EN_PIN, TEST_SECOND_EN_PIN, TEST_THIRD_EN_PIN };
+
+    for (uint8_t i{ 0 }; i < 3; i++) {
+        controllers[i] = HD44780Model();
+        controllers[i].useFourBitPins(TEST_RS_PIN, TEST_RW_PIN, en_pins[i], TEST_DB7_PIN, TEST_DB6_PIN, TEST_DB5_PIN, TEST_DB4_PIN);
+        mock_attach(&controllers[i]);
+    }
+}
+
+void tearDown() {}
+
+
+static unsigned long total_transactions() {
+    return controllers[0].transactions + controllers[1].transactions + controllers[2].transactions;
+}
+
+
+void test_each_display_gets_its_own_text() {
+    LCD_Setup first_lcd(TEST_RS_PIN, TEST_RW_PIN, TEST_EN_PIN, 4, true, false, TEST_DB7_PIN, TEST_DB6_PIN, TEST_DB5_PIN, TEST_DB4_PIN);
+    LCD_Setup second_lcd(TEST_RS_PIN, TEST_RW_PIN, TEST_SECOND_EN_PIN, 4, true, false, TEST_DB7_PIN, TEST_DB6_PIN, TEST_DB5_PIN, TEST_DB4_PIN);
+
+    LCD_Setup *displays[2]{ &first_lcd, &second_lcd };
+    LCD_TransmitQueue queues[2];
+    LCD_Bus bus(displays, queues, 2);
+
+    first_lcd.display("first");
+    second_lcd.display("second");
+    first_lcd.moveCursor(2, 1);
+    first_lcd.display("line 2");
+    bus.flush();
+
+    TEST_ASSERT_EQUAL_STRING("first           ", controllers[0].line(1).c_str());
+    TEST_ASSERT_EQUAL_STRING("line 2          ", controllers[0].line(2).c_str());
+    TEST_ASSERT_EQUAL_STRING("second          ", controllers[1].line(1).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+// the execution time of one display overlaps with the transfers to the others
+void test_round_robin_throughput() {
+    LCD_Setup first_lcd(TEST_RS_PIN, TEST_RW_PIN, TEST_EN_PIN, 4, true, false, TEST_DB7_PIN, TEST_DB6_PIN, TEST_DB5_PIN, TEST_DB4_PIN);
+    LCD_Setup second_lcd(TEST_RS_PIN, TEST_RW_PIN, TEST_SECOND_EN_PIN, 4, true, false, TEST_DB7_PIN, TEST_DB6_PIN, TEST_DB5_PIN, TEST_DB4_PIN);
+    LCD_Setup third_lcd(TEST_RS_PIN, TEST_RW_PIN, TEST_THIRD_EN_PIN, 4, true, false, TEST_DB7_PIN, TEST_DB6_PIN, TEST_DB5_PIN, TEST_DB4_PIN);
+
+    // a digitalWrite takes about 4 microseconds on an Uno, which is what the bus overlaps with the execution times
+    mock().gpio_write_time = 4;
+
+    // one display on its own, as a baseline
+    unsigned long start_transactions{ total_transactions() };
+    unsigned long start_time{ mock().clock };
+    first_lcd.display("0123456789ABCDEF");
+    const unsigned long single_time{ mock().clock - start_time };
+    report("16 characters to 1 display", total_transactions() - start_transactions, single_time);
+
+    LCD_Setup *displays[3]{ &first_lcd, &second_lcd, &third_lcd };
+    LCD_TransmitQueue queues[3];
+    LCD_Bus bus(displays, queues, 3);
+
+    start_transactions = total_transactions();
+    start_time = mock().clock;
+
+    for (uint8_t i{ 0 }; i < 3; i++) {
+        displays[i]->moveCursor(2, 1);
+        bus.flush();
+    }
+
+    for (uint8_t i{ 0 }; i < 3; i++) {
+        displays[i]->display("0123456789ABCDEF");
+    }
+
+    bus.flush();
+    const unsigned long bus_time{ mock().clock - start_time };
+    report("16 characters to each of 3 displays on a bus", total_transactions() - start_transactions, bus_time);
+
+    for (uint8_t i{ 0 }; i < 3; i++) {
+        TEST_ASSERT_EQUAL_STRING("0123456789ABCDEF", controllers[i].line(2).c_str());
+    }
+
+    TEST_ASSERT_LESS_THAN(3 * single_time, bus_time);
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+LCD_Bus *interrupted_bus;
+
+static void service_bus_from_interrupt() {
+    interrupted_bus->service();
+}
+
+
+// a timer interrupt servicing the bus while the sketch is in the middle of a transfer to another display mustn't touch the shared pins
+void test_servicing_from_an_interrupt() {
+    LCD_Setup first_lcd(TEST_RS_PIN, TEST_RW_PIN, TEST_EN_PIN, 4, true, false, TEST_DB7_PIN, TEST_DB6_PIN, TEST_DB5_PIN, TEST_DB4_PIN);
+    LCD_Setup second_lcd(TEST_RS_PIN, TEST_RW_PIN, TEST_SECOND_EN_PIN, 4, true, false, TEST_DB7_PIN, TEST_DB6_PIN, TEST_DB5_PIN, TEST_DB4_PIN);
+
+    LCD_Setup *displays[2]{ &first_lcd, &second_lcd };
+    LCD_TransmitQueue queues[2];
+    LCD_Bus bus(displays, queues, 2);
+
+    interrupted_bus = &bus;
+    mock().interrupt_handler = service_bus_from_interrupt;
+
+    // longer than the queues, so the sketch also services them while it waits for room
+    first_lcd.display("0123456789ABCDEFGHIJ0123456789ABCDEFGHIJ");
+    second_lcd.display("abcdefghijklmnopqrstabcdefghijklmnopqrst");
+    bus.flush();
+
+    mock().interrupt_handler = nullptr;
+
+    TEST_ASSERT_EQUAL_STRING("0123456789ABCDEFGHIJ0123456789ABCDEFGHIJ", DDRAM_text(controllers[0], 1, 40).c_str());
+    TEST_ASSERT_EQUAL_STRING("abcdefghijklmnopqrstabcdefghijklmnopqrst", DDRAM_text(controllers[1], 1, 40).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_each_display_gets_its_own_text);
+    RUN_TEST(test_round_robin_throughput);
+    RUN_TEST(test_servicing_from_an_interrupt);
+    return UNITY_END();
+}
@@ -0,0 +1,112 @@
+#include <test_lcd.h>
+#include <arduino_lcdpp.h>
+
+// Busy flag polling (see 'useBusyFlag'): the library moves on as soon as the LCD is ready instead of waiting the worst case
+
+HD44780Model controller;
+
+void setUp() {
+    mock_reset();
+    attach_test_controller(controller);
+}
+
+void tearDown() {}
+
+
+static unsigned long refresh_time(LCD_Setup &lcd) {
+    const unsigned long start_time{ mock().clock };
+
+    lcd.moveCursor(1, 1);
+    lcd.display("0123456789ABCDEF");
+    lcd.moveCursor(2, 1);
+    lcd.display("FEDCBA9876543210");
+
+    return mock().clock - start_time;
+}
+
+
+void test_polling_is_faster_than_fixed_delays() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+
+    // a fast controller finishes well before the profile's worst case
+    controller.data_write_time = 10;
+    controller.command_time = 10;
+
+    const unsigned long start_transactions{ controller.transactions };
+    const unsigned long fixed_delay_time{ refresh_time(lcd) };
+    const unsigned long refresh_transactions{ controller.transactions - start_transactions };
+
+    lcd.useBusyFlag();
+    const unsigned long polling_time{ refresh_time(lcd) };
+
+    report("16x2 refresh with fixed delays", refresh_transactions, fixed_delay_time);
+    report("16x2 refresh polling the busy flag", refresh_transactions, polling_time);
+
+    TEST_ASSERT_LESS_THAN(fixed_delay_time, polling_time);
+    TEST_ASSERT_GREATER_THAN(0, controller.busy_flag_reads);
+    TEST_ASSERT_EQUAL_STRING("FEDCBA9876543210", controller.line(2).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+// the busy flag is read until the LCD is ready, which can be right up to the profile's time
+void test_polling_waits_for_slow_controllers() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.useBusyFlag();
+
+    controller.data_write_time = 40;
+
+    lcd.display("slow");
+
+    TEST_ASSERT_EQUAL_STRING("slow            ", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_polling_during_initialization() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.useBusyFlag();
+    lcd.begin(LCD_power_is_stable);
+    lcd.display("ok");
+
+    TEST_ASSERT_EQUAL_STRING("ok              ", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_polling_in_8_bit_mode() {
+    attach_test_controller(controller, true);
+    LCD_Setup lcd(TEST_RS_PIN, TEST_RW_PIN, TEST_EN_PIN, 8, true, false, TEST_DB7_PIN, TEST_DB6_PIN, TEST_DB5_PIN, TEST_DB4_PIN, TEST_DB3_PIN, TEST_DB2_PIN, TEST_DB1_PIN, TEST_DB0_PIN);
+    lcd.useBusyFlag();
+
+    lcd.display("8-bit");
+
+    TEST_ASSERT_EQUAL_STRING("8-bit           ", controller.line(1).c_str());
+    TEST_ASSERT_GREATER_THAN(0, controller.busy_flag_reads);
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+// an input that nothing drives would read "ready" without its pull-up, so the timeout has to take over
+void test_timeout_when_nothing_drives_the_bus() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.useBusyFlag();
+
+    controller.answersReads = false;
+
+    lcd.display("0123456789ABCDEF");
+
+    TEST_ASSERT_EQUAL_STRING("0123456789ABCDEF", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_polling_is_faster_than_fixed_delays);
+    RUN_TEST(test_polling_waits_for_slow_controllers);
+    RUN_TEST(test_polling_during_initialization);
+    RUN_TEST(test_polling_in_8_bit_mode);
+    RUN_TEST(test_timeout_when_nothing_drives_the_bus);
+    return UNITY_END();
+}
@@ -0,0 +1,92 @@
+#include <test_lcd.h>
+#include <arduino_lcdpp.h>
+
+// moveCursor sets the DDRAM address directly, so every move is one instruction however far the cursor goes
+
+HD44780Model controller;
+
+void setUp() {
+    mock_reset();
+    attach_test_controller(controller);
+}
+
+void tearDown() {}
+
+
+void test_every_move_is_one_instruction() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+
+    const uint8_t targets[][2]{ { 2, 40 }, { 1, 1 }, { 1, 40 }, { 2, 1 }, { 1, 17 }, { 2, 20 } };
+
+    for (const auto &target : targets) {
+        const unsigned long start_transactions{ controller.transactions };
+        lcd.moveCursor(target[0], target[1]);
+
+        TEST_ASSERT_EQUAL(1, controller.transactions - start_transactions);
+        TEST_ASSERT_EQUAL((target[0] == 2 ? 0x40 : 0) + target[1] - 1, controller.address_counter);
+    }
+
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_characters_go_where_the_cursor_is() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+
+    lcd.moveCursor(2, 5);
+    lcd.display("two");
+    lcd.moveCursor(1, 14);
+    lcd.display("one");
+
+    TEST_ASSERT_EQUAL_STRING("             one", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL_STRING("    two         ", controller.line(2).c_str());
+}
+
+
+void test_text_wraps_from_line_1_to_line_2() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+
+    lcd.moveCursor(1, 39);
+    lcd.display("abcd");
+    lcd.display("e");
+
+    TEST_ASSERT_EQUAL('a', controller.ddram[0x26]);
+    TEST_ASSERT_EQUAL('b', controller.ddram[0x27]);
+    TEST_ASSERT_EQUAL_STRING("cde             ", controller.line(2).c_str());
+    TEST_ASSERT_EQUAL(0x43, controller.address_counter);
+}
+
+
+void test_out_of_range_moves_are_clamped() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+
+    lcd.moveCursor(3, 50);
+    lcd.display("x");
+
+    TEST_ASSERT_EQUAL(0, mock_violations());
+    TEST_ASSERT_EQUAL(1, controller.data_writes);
+}
+
+
+void test_reset_positions() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+
+    lcd.moveCursor(2, 8);
+    lcd.moveDisplayLeft(3);
+    lcd.resetPositions();
+    lcd.display("home");
+
+    TEST_ASSERT_EQUAL(0, controller.display_shift);
+    TEST_ASSERT_EQUAL_STRING("home            ", controller.line(1).c_str());
+}
+
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_every_move_is_one_instruction);
+    RUN_TEST(test_characters_go_where_the_cursor_is);
+    RUN_TEST(test_text_wraps_from_line_1_to_line_2);
+    RUN_TEST(test_out_of_range_moves_are_clamped);
+    RUN_TEST(test_reset_positions);
+    return UNITY_END();
+}
@@ -0,0 +1,119 @@
+#include <test_lcd.h>
+#include <arduino_lcdpp.h>
+
+// Right-aligned fields (see 'setupField'): written last digit first in decrement mode, only blanking what's left of the previous number
+
+HD44780Model controller;
+LCD_Field field;
+
+void setUp() {
+    mock_reset();
+    attach_test_controller(controller);
+}
+
+void tearDown() {}
+
+
+void test_numbers_are_right_aligned() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.display("Count:");
+    lcd.setupField(&field, 1, 16, 6);
+
+    lcd.displayField(&field, 12345);
+    TEST_ASSERT_EQUAL_STRING("Count:     12345", controller.line(1).c_str());
+
+    lcd.displayField(&field, 7);
+    TEST_ASSERT_EQUAL_STRING("Count:         7", controller.line(1).c_str());
+
+    lcd.displayField(&field, -42);
+    TEST_ASSERT_EQUAL_STRING("Count:       -42", controller.line(1).c_str());
+
+    // too long for the field, so the leftmost digits are lost
+    lcd.displayField(&field, 123456789L);
+    TEST_ASSERT_EQUAL_STRING("Count:    456789", controller.line(1).c_str());
+
+    TEST_ASSERT_TRUE(controller.incrementsAddress);
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_same_length_update_cost() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.setupField(&field, 2, 10, 5);
+    lcd.displayField(&field, 100);
+
+    const unsigned long start_transactions{ controller.transactions };
+    const unsigned long start_time{ mock().clock };
+    lcd.displayField(&field, 101);
+
+    report("3-digit field update", controller.transactions - start_transactions, mock().clock - start_time);
+
+    // the digits plus the entry mode twice and the cursor move
+    TEST_ASSERT_EQUAL(3 + 3, controller.transactions - start_transactions);
+    TEST_ASSERT_EQUAL_STRING("       101      ", controller.line(2).c_str());
+}
+
+
+void test_writing_continues_after_the_field() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.setupField(&field, 1, 8, 4);
+    lcd.displayField(&field, 55);
+    lcd.display("x");
+
+    // the whole field was blanked the first time, and the cursor is left on the block before it
+    TEST_ASSERT_EQUAL_STRING("   x  55        ", controller.line(1).c_str());
+}
+
+
+void test_field_in_the_framebuffer() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    LCD_Framebuffer framebuffer;
+    lcd.useFramebuffer(&framebuffer);
+
+    lcd.setupField(&field, 2, 16, 4);
+    lcd.displayField(&field, 987);
+    lcd.flush();
+
+    TEST_ASSERT_EQUAL_STRING("             987", controller.line(2).c_str());
+    TEST_ASSERT_TRUE(controller.incrementsAddress);
+}
+
+
+// the right edge is counted from the start of the page, so on the 2nd page it can wrap round to near the start of the line. The field then only gets the blocks up to there
+void test_field_wrapping_round_the_page() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    LCD_Framebuffer framebuffer;
+    lcd.useFramebuffer(&framebuffer);
+
+    lcd.beginPage();
+    lcd.setupField(&field, 1, 30, 20);
+    lcd.displayField(&field, 123);
+    lcd.displayField(&field, 4567890L);
+    lcd.flush();
+
+    TEST_ASSERT_EQUAL_STRING("567890          ", controller.line(1).c_str());
+}
+
+
+void test_field_wrapping_round_the_page_without_a_framebuffer() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+
+    lcd.beginPage();
+    lcd.setupField(&field, 1, 30, 20);
+    lcd.displayField(&field, 12);
+
+    TEST_ASSERT_EQUAL_STRING("    12          ", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL_STRING(std::string(40, ' ').c_str(), DDRAM_text(controller, 2, 40).c_str());
+}
+
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_numbers_are_right_aligned);
+    RUN_TEST(test_same_length_update_cost);
+    RUN_TEST(test_writing_continues_after_the_field);
+    RUN_TEST(test_field_in_the_framebuffer);
+    RUN_TEST(test_field_wrapping_round_the_page);
+    RUN_TEST(test_field_wrapping_round_the_page_without_a_framebuffer);
+    return UNITY_END();
+}
@@ -0,0 +1,128 @@
+#include <test_lcd.h>
+#include <arduino_lcdpp.h>
+
+// Framebuffer (see 'useFramebuffer'): characters are written to RAM and 'flush' only sends the blocks that changed
+
+HD44780Model controller;
+LCD_Framebuffer framebuffer;
+
+void setUp() {
+    mock_reset();
+    attach_test_controller(controller);
+}
+
+void tearDown() {}
+
+
+static void draw_dashboard(LCD_Setup &lcd, const int temperature, const int humidity) {
+    lcd.moveCursor(1, 1);
+    lcd.display("Temp: ");
+    lcd.displayNumber(temperature, 10, 3);
+    lcd.display(" C      ");
+    lcd.moveCursor(2, 1);
+    lcd.display("Humidity: ");
+    lcd.displayNumber(humidity, 10, 3);
+    lcd.display(" % ");
+}
+
+
+void test_nothing_is_sent_before_flush() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.useFramebuffer(&framebuffer);
+
+    const unsigned long start_transactions{ controller.transactions };
+    draw_dashboard(lcd, 21, 40);
+
+    TEST_ASSERT_EQUAL(0, controller.transactions - start_transactions);
+
+    lcd.flush();
+
+    TEST_ASSERT_EQUAL_STRING("Temp:  21 C     ", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL_STRING("Humidity:  40 % ", controller.line(2).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_flush_only_sends_changed_blocks() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+
+    // the same refresh without a framebuffer, as a baseline
+    unsigned long start_transactions{ controller.transactions };
+    unsigned long start_time{ mock().clock };
+    draw_dashboard(lcd, 22, 41);
+    report("dashboard refresh without a framebuffer", controller.transactions - start_transactions, mock().clock - start_time);
+
+    lcd.useFramebuffer(&framebuffer);
+    draw_dashboard(lcd, 21, 40);
+    lcd.flush();
+
+    start_transactions = controller.transactions;
+    start_time = mock().clock;
+    draw_dashboard(lcd, 22, 41);
+    lcd.flush();
+    const unsigned long flush_transactions{ controller.transactions - start_transactions };
+    report("dashboard refresh with a framebuffer", flush_transactions, mock().clock - start_time);
+
+    // 2 changed blocks, each with its DDRAM address, and the cursor put back where the next character goes
+    TEST_ASSERT_EQUAL(5, flush_transactions);
+    TEST_ASSERT_EQUAL_STRING("Temp:  22 C     ", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL_STRING("Humidity:  41 % ", controller.line(2).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_adjacent_changes_share_one_address() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.useFramebuffer(&framebuffer);
+
+    lcd.display("aaaaaaaa");
+    lcd.flush();
+
+    const unsigned long start_transactions{ controller.transactions };
+    lcd.moveCursor(1, 3);
+    lcd.display("bbbb");
+    lcd.flush();
+
+    // the LCD's cursor ends up right after the run, which is where the next character goes anyway
+    TEST_ASSERT_EQUAL(1 + 4, controller.transactions - start_transactions);
+    TEST_ASSERT_EQUAL_STRING("aabbbbaa        ", controller.line(1).c_str());
+}
+
+
+void test_unchanged_redraw_sends_nothing() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.useFramebuffer(&framebuffer);
+
+    draw_dashboard(lcd, 21, 40);
+    lcd.flush();
+
+    const unsigned long start_transactions{ controller.transactions };
+    draw_dashboard(lcd, 21, 40);
+    lcd.flush();
+
+    // only the cursor is put back
+    TEST_ASSERT_LESS_OR_EQUAL(1, controller.transactions - start_transactions);
+}
+
+
+void test_detaching_flushes_what_is_left() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.useFramebuffer(&framebuffer);
+
+    lcd.display("pending");
+    lcd.useFramebuffer(nullptr);
+    lcd.display("!");
+
+    TEST_ASSERT_EQUAL_STRING("pending!        ", controller.line(1).c_str());
+}
+
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_nothing_is_sent_before_flush);
+    RUN_TEST(test_flush_only_sends_changed_blocks);
+    RUN_TEST(test_adjacent_changes_share_one_address);
+    RUN_TEST(test_unchanged_redraw_sends_nothing);
+    RUN_TEST(test_detaching_flushes_what_is_left);
+    return UNITY_END();
+}
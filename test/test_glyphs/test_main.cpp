@@ -0,0 +1,92 @@
+#include <test_lcd.h>
+#include <arduino_lcdpp.h>
+
+// Custom characters and the glyph cache (see 'useGlyphCache'): a bitmap is only uploaded when it isn't in a slot already
+
+HD44780Model controller;
+LCD_GlyphCache glyph_cache;
+
+const byte heart[8]{ B00000, B01010, B11111, B11111, B01110, B00100, B00000, B00000 };
+const byte tall_heart[11]{ B00000, B01010, B11111, B11111, B01110, B00100, B00000, B00000, B00000, B00000, B00000 };
+const byte tall_arrow[11]{ B00100, B01110, B10101, B00100, B00100, B00100, B00100, B00100, B00100, B00100, B00000 };
+
+void setUp() {
+    mock_reset();
+    attach_test_controller(controller);
+}
+
+void tearDown() {}
+
+
+void test_custom_character() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+
+    lcd.display("a");
+    lcd.createCustomCharacter(3, heart);
+    lcd.displayCustomCharacter(3);
+
+    TEST_ASSERT_EQUAL_MEMORY(heart, &controller.cgram[24], 8);
+    TEST_ASSERT_EQUAL('a', controller.ddram[0]);
+    TEST_ASSERT_EQUAL(3, controller.ddram[1]);
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+// with the 5x10 font, slot k is shown by the character code 2k
+void test_custom_character_5x10() {
+    LCD_Setup lcd(TEST_RS_PIN, TEST_RW_PIN, TEST_EN_PIN, 4, false, true, TEST_DB7_PIN, TEST_DB6_PIN, TEST_DB5_PIN, TEST_DB4_PIN);
+
+    lcd.createCustomCharacter(1, tall_arrow);
+    lcd.displayCustomCharacter(1);
+
+    TEST_ASSERT_EQUAL_MEMORY(tall_arrow, &controller.cgram[16], 11);
+    TEST_ASSERT_EQUAL_MEMORY(tall_arrow, controller.glyph(controller.ddram[0]), 11);
+
+    lcd.useGlyphCache(&glyph_cache);
+    lcd.displayGlyph(tall_heart);
+    lcd.displayGlyph(tall_arrow);
+
+    TEST_ASSERT_EQUAL_MEMORY(tall_heart, controller.glyph(controller.ddram[1]), 11);
+    TEST_ASSERT_EQUAL_MEMORY(tall_arrow, controller.glyph(controller.ddram[2]), 11);
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_cached_glyphs_are_not_uploaded_again() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.useGlyphCache(&glyph_cache);
+
+    lcd.displayGlyph(heart);
+    const unsigned long start_transactions{ controller.transactions };
+    lcd.displayGlyph(heart);
+
+    TEST_ASSERT_EQUAL(1, controller.transactions - start_transactions);
+    TEST_ASSERT_EQUAL(controller.ddram[0], controller.ddram[1]);
+    TEST_ASSERT_EQUAL_MEMORY(heart, controller.glyph(controller.ddram[1]), 8);
+}
+
+
+void test_least_recently_used_slot_is_replaced() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.useGlyphCache(&glyph_cache);
+
+    byte glyphs[9][8]{};
+    for (uint8_t i{ 0 }; i < 9; i++) { glyphs[i][0] = i + 1; }
+
+    for (uint8_t i{ 0 }; i < 8; i++) { TEST_ASSERT_EQUAL(i, lcd.loadGlyph(glyphs[i])); }
+
+    // slot 0 is used again, so slot 1 is now the oldest
+    lcd.loadGlyph(glyphs[0]);
+    TEST_ASSERT_EQUAL(1, lcd.loadGlyph(glyphs[8]));
+    TEST_ASSERT_EQUAL(9, controller.cgram[8]);
+}
+
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_custom_character);
+    RUN_TEST(test_custom_character_5x10);
+    RUN_TEST(test_cached_glyphs_are_not_uploaded_again);
+    RUN_TEST(test_least_recently_used_slot_is_replaced);
+    return UNITY_END();
+}
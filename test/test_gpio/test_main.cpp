@@ -0,0 +1,89 @@
+#include <test_lcd.h>
+#include <arduino_lcdpp.h>
+
+// Pin writes of the GPIO backends: digitalWrite, or the data pins' port in one go with 'LCD_port_registers' (see 'find_pin_ports').
+// [env:native_ports] builds this suite with the port path on, against the emulated ports of an Uno (see Arduino.h)
+
+HD44780Model controller;
+
+void setUp() {
+    mock_reset();
+    attach_test_controller(controller);
+}
+
+void tearDown() {}
+
+
+#ifndef LCD_port_registers
+void test_GPIO_writes_per_character() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+
+    const unsigned long start_gpio_writes{ mock().gpio_writes };
+    const unsigned long start_time{ mock().clock };
+    mock().gpio_write_time = 4;
+
+    lcd.display("0123456789ABCDEF");
+
+    char scenario[80];
+    snprintf(scenario, sizeof(scenario), "16 characters with digitalWrite (%lu pin writes)", mock().gpio_writes - start_gpio_writes);
+    report(scenario, 16, mock().clock - start_time);
+
+    TEST_ASSERT_EQUAL(16 * (4 + 2 + 4 + 2) + 2, mock().gpio_writes - start_gpio_writes);
+    TEST_ASSERT_EQUAL_STRING("0123456789ABCDEF", controller.line(1).c_str());
+}
+#else
+void test_port_writes_per_character() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+
+    const unsigned long start_gpio_writes{ mock().gpio_writes };
+    const unsigned long start_port_writes{ mock().port_writes };
+    const unsigned long start_time{ mock().clock };
+    lcd.resetStats();
+    mock().gpio_write_time = 4;
+
+    lcd.display("0123456789ABCDEF");
+
+    const unsigned long port_writes{ lcd.getStats().GPIO_writes - (mock().gpio_writes - start_gpio_writes) };
+
+    char scenario[80];
+    snprintf(scenario, sizeof(scenario), "16 characters through the ports (%lu port writes, %lu digitalWrite calls)", port_writes, mock().gpio_writes - start_gpio_writes);
+    report(scenario, 16, mock().clock - start_time);
+
+    // only rs & rw still go through digitalWrite; each nibble is one data port write and 2 enable port writes
+    TEST_ASSERT_EQUAL(2, mock().gpio_writes - start_gpio_writes);
+    TEST_ASSERT_EQUAL(16 * (1 + 2 + 1 + 2), port_writes);
+
+    // the enable edges always change a pin, a data write only when the nibble differs from the previous one
+    TEST_ASSERT_GREATER_OR_EQUAL(16 * 4, mock().port_writes - start_port_writes);
+    TEST_ASSERT_LESS_OR_EQUAL(port_writes, mock().port_writes - start_port_writes);
+
+    TEST_ASSERT_EQUAL_STRING("0123456789ABCDEF", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_port_writes_keep_the_other_pins() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.useBusyFlag();
+
+    lcd.display("busy flag");
+    lcd.moveCursor(2, 1);
+    lcd.display("& ports");
+
+    TEST_ASSERT_EQUAL_STRING("busy flag       ", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL_STRING("& ports         ", controller.line(2).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+#endif
+
+
+int main() {
+    UNITY_BEGIN();
+#ifndef LCD_port_registers
+    RUN_TEST(test_GPIO_writes_per_character);
+#else
+    RUN_TEST(test_port_writes_per_character);
+    RUN_TEST(test_port_writes_keep_the_other_pins);
+#endif
+    return UNITY_END();
+}
@@ -0,0 +1,82 @@
+#include <test_lcd.h>
+#include <Wire.h>
+#include <arduino_lcdpp.h>
+
+// PCF8574 backpack (see the I2C constructor): frames go out in as few Wire transmissions as its buffer allows
+
+#define TEST_BACKPACK_ADDRESS 0x27
+
+HD44780Model controller;
+LCD_SRFrames frames;
+
+void setUp() {
+    mock_reset();
+    attach_SR_controller(controller, true);
+
+    // the backpack wires DB4-DB7 to P4-P7, rs/rw/en to P0-P2 (see Wire.h)
+    Wire = TwoWire();
+    Wire.backpack = &controller;
+}
+
+void tearDown() {}
+
+
+void test_refresh_through_the_backpack() {
+    LCD_Setup lcd(TEST_BACKPACK_ADDRESS, true, false, LCD_I2C_send, &frames);
+    Wire.begin();
+    lcd.begin();
+
+    const unsigned long start_transmissions{ Wire.transmissions };
+    const unsigned long start_transactions{ controller.transactions };
+    const unsigned long start_time{ mock().clock };
+
+    lcd.display("0123456789ABCDEF");
+    lcd.moveCursor(2, 1);
+    lcd.display("FEDCBA9876543210");
+
+    char scenario[80];
+    snprintf(scenario, sizeof(scenario), "32 characters over I2C (%lu transmissions)", Wire.transmissions - start_transmissions);
+    report(scenario, controller.transactions - start_transactions, mock().clock - start_time);
+
+    TEST_ASSERT_EQUAL(TEST_BACKPACK_ADDRESS, Wire.address);
+    TEST_ASSERT_EQUAL_STRING("0123456789ABCDEF", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL_STRING("FEDCBA9876543210", controller.line(2).c_str());
+    TEST_ASSERT_EQUAL(0, Wire.dropped_bytes);
+    TEST_ASSERT_LESS_THAN(2 * 32, Wire.transmissions - start_transmissions);
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_backlight() {
+    LCD_Setup lcd(TEST_BACKPACK_ADDRESS, true, false, LCD_I2C_send, &frames);
+    lcd.begin();
+
+    TEST_ASSERT_TRUE(Wire.isBacklightOn);
+
+    lcd.backlightOFF();
+    TEST_ASSERT_FALSE(Wire.isBacklightOn);
+
+    // characters keep the backlight's state
+    lcd.display("dark");
+    TEST_ASSERT_FALSE(Wire.isBacklightOn);
+
+    lcd.backlightON();
+    TEST_ASSERT_TRUE(Wire.isBacklightOn);
+    TEST_ASSERT_EQUAL_STRING("dark            ", controller.line(1).c_str());
+}
+
+
+void test_constructor_leaves_the_bus_alone() {
+    LCD_Setup lcd(TEST_BACKPACK_ADDRESS, true, false, LCD_I2C_send, &frames);
+
+    TEST_ASSERT_EQUAL(0, Wire.transmissions);
+}
+
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_refresh_through_the_backpack);
+    RUN_TEST(test_backlight);
+    RUN_TEST(test_constructor_leaves_the_bus_alone);
+    return UNITY_END();
+}
@@ -0,0 +1,62 @@
+#include <test_lcd.h>
+#include <arduino_lcdpp.h>
+#include <new>
+
+// Instances store their pins & configuration by value, so they keep working whatever happens to the stack they were made on
+
+HD44780Model controller;
+
+void setUp() {
+    mock_reset();
+}
+
+void tearDown() {}
+
+
+// the pins are stored by value, so instances made in other scopes keep driving their own pins
+static LCD_Setup *make_lcd_in_other_scope(const uint8_t en_pin) {
+    static uint8_t storage[2][sizeof(LCD_Setup)];
+    const uint8_t rs{ TEST_RS_PIN };
+    const uint8_t rw{ TEST_RW_PIN };
+
+    return new (storage[en_pin == TEST_EN_PIN ? 0 : 1]) LCD_Setup(rs, rw, en_pin, 4, true, false, TEST_DB7_PIN, TEST_DB6_PIN, TEST_DB5_PIN, TEST_DB4_PIN);
+}
+
+
+void test_instances_keep_their_own_pins() {
+    HD44780Model second_controller;
+
+    attach_test_controller(controller);
+    second_controller.useFourBitPins(TEST_RS_PIN, TEST_RW_PIN, 13, TEST_DB7_PIN, TEST_DB6_PIN, TEST_DB5_PIN, TEST_DB4_PIN);
+    mock_attach(&second_controller);
+
+    LCD_Setup *first_lcd{ make_lcd_in_other_scope(TEST_EN_PIN) };
+    LCD_Setup *second_lcd{ make_lcd_in_other_scope(13) };
+
+    // overwrites the stack where the constructors' parameters were
+    volatile char scratch[256];
+    memset((char *)scratch, 0x55, sizeof(scratch));
+
+    first_lcd->display("first");
+    second_lcd->display("second");
+
+    TEST_ASSERT_EQUAL_STRING("first           ", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL_STRING("second          ", second_controller.line(1).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+// pointers are wider on the host than on AVR, so this is only reported
+void test_instance_size() {
+    char message[40];
+    snprintf(message, sizeof(message), "sizeof(LCD_Setup) = %u", (unsigned int)sizeof(LCD_Setup));
+    TEST_MESSAGE(message);
+}
+
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_instances_keep_their_own_pins);
+    RUN_TEST(test_instance_size);
+    return UNITY_END();
+}
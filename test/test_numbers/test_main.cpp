@@ -0,0 +1,170 @@
+#include <test_lcd.h>
+#include <arduino_lcdpp.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <new>
+
+// Integer & fixed-point formatting, checked against snprintf (exhaustively for the 8 & 16-bit types)
+
+HD44780Model controller;
+LCD_Setup *lcd;
+
+void setUp() {
+    mock_reset();
+    attach_test_controller(controller);
+
+    static uint8_t storage[sizeof(LCD_Setup)];
+    lcd = new (storage) LCD_Setup(TEST_4_BIT_LCD);
+}
+
+void tearDown() {
+    lcd->~LCD_Setup();
+}
+
+
+// what the last call put on line 1, assuming it started at the first block
+static std::string displayed_text() {
+    return DDRAM_text(controller, 1, controller.address_counter);
+}
+
+template <typename INT_TYPE>
+static void check_number(const INT_TYPE number, const char *expected) {
+    lcd->moveCursor(1, 1);
+    lcd->display(number);
+
+    TEST_ASSERT_EQUAL_STRING(expected, displayed_text().c_str());
+}
+
+
+void test_every_int8_and_uint8() {
+    char expected[8];
+
+    for (int i{ INT8_MIN }; i <= INT8_MAX; i++) {
+        snprintf(expected, sizeof(expected), "%d", i);
+        check_number((int8_t)i, expected);
+    }
+
+    for (int i{ 0 }; i <= UINT8_MAX; i++) {
+        snprintf(expected, sizeof(expected), "%d", i);
+        check_number((uint8_t)i, expected);
+    }
+}
+
+
+void test_every_int16_and_uint16() {
+    char expected[8];
+
+    for (long i{ INT16_MIN }; i <= INT16_MAX; i++) {
+        snprintf(expected, sizeof(expected), "%ld", i);
+        check_number((int16_t)i, expected);
+    }
+
+    for (long i{ 0 }; i <= UINT16_MAX; i++) {
+        snprintf(expected, sizeof(expected), "%ld", i);
+        check_number((uint16_t)i, expected);
+    }
+}
+
+
+void test_32_and_64_bit_edges() {
+    check_number(INT32_MIN, "-2147483648");
+    check_number(INT32_MAX, "2147483647");
+    check_number(UINT32_MAX, "4294967295");
+    check_number(LLONG_MIN, "-9223372036854775808");
+    check_number(LLONG_MAX, "9223372036854775807");
+    check_number(ULLONG_MAX, "18446744073709551615");
+    check_number(0L, "0");
+    check_number(-1L, "-1");
+}
+
+
+void test_bases_width_and_padding() {
+    const struct { long number; uint8_t base; uint8_t width; bool zero_padding; const char *expected; } cases[]{
+        { -42, 10, 5, false, "  -42" },
+        { 0x3F, 16, 4, true, "003F" },
+        { 5, 2, 0, false, "101" },
+        { -7, 10, 4, true, "-007" },
+        { 255, 8, 0, false, "377" },
+        { 123456, 10, 3, false, "123456" },
+        { 0, 16, 2, true, "00" },
+        { 5, 0, 0, false, "101" }, // bases outside 2-16 are clamped
+        { 5, 1, 0, false, "101" },
+        { 255, 17, 0, false, "FF" },
+        { 255, 36, 0, false, "FF" },
+    };
+
+    for (const auto &test_case : cases) {
+        lcd->moveCursor(1, 1);
+        lcd->displayNumber(test_case.number, test_case.base, test_case.width, test_case.zero_padding);
+
+        TEST_ASSERT_EQUAL_STRING(test_case.expected, displayed_text().c_str());
+    }
+
+    lcd->moveCursor(1, 1);
+    lcd->displayNumber(ULLONG_MAX, 2);
+
+    // 64 digits carry on from the end of line 1 to line 2
+    TEST_ASSERT_EQUAL_STRING(std::string(40, '1').c_str(), DDRAM_text(controller, 1, 40).c_str());
+    TEST_ASSERT_EQUAL_STRING(std::string(24, '1').c_str(), DDRAM_text(controller, 2, 24).c_str());
+    TEST_ASSERT_EQUAL(0x40 + 24, controller.address_counter);
+}
+
+
+void test_bools() {
+    check_number(true, "1");
+    check_number(false, "0");
+}
+
+
+void test_decimal_fixed_and_scaled() {
+    lcd->moveCursor(1, 1);
+    lcd->displayDecimal(3.14159, 4);
+    TEST_ASSERT_EQUAL_STRING("3.1416", displayed_text().c_str());
+
+    lcd->moveCursor(1, 1);
+    lcd->displayDecimal(-0.001);
+    TEST_ASSERT_EQUAL_STRING("0.00", displayed_text().c_str());
+
+    lcd->moveCursor(1, 1);
+    lcd->displayFixed(98304L, 16, 2);
+    TEST_ASSERT_EQUAL_STRING("1.50", displayed_text().c_str());
+
+    lcd->moveCursor(1, 1);
+    lcd->displayFixed(-98304L, 16, 2);
+    TEST_ASSERT_EQUAL_STRING("-1.50", displayed_text().c_str());
+
+    lcd->moveCursor(1, 1);
+    lcd->displayScaled(2150, 2);
+    TEST_ASSERT_EQUAL_STRING("21.50", displayed_text().c_str());
+
+    lcd->moveCursor(1, 1);
+    lcd->displayScaled(-5, 3);
+    TEST_ASSERT_EQUAL_STRING("-0.005", displayed_text().c_str());
+}
+
+
+void test_formatting_benchmark() {
+    const unsigned long start_transactions{ controller.transactions };
+    const unsigned long start_time{ mock().clock };
+
+    for (long i{ 0 }; i < 1000; i += 7) {
+        lcd->moveCursor(1, 1);
+        lcd->displayNumber(i * 1009, 10, 8);
+    }
+
+    report("143 right-aligned 8-digit numbers", controller.transactions - start_transactions, mock().clock - start_time);
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_every_int8_and_uint8);
+    RUN_TEST(test_every_int16_and_uint16);
+    RUN_TEST(test_32_and_64_bit_edges);
+    RUN_TEST(test_bases_width_and_padding);
+    RUN_TEST(test_bools);
+    RUN_TEST(test_decimal_fixed_and_scaled);
+    RUN_TEST(test_formatting_benchmark);
+    return UNITY_END();
+}
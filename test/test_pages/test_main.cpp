@@ -0,0 +1,114 @@
+#include <test_lcd.h>
+#include <arduino_lcdpp.h>
+
+// Pages (see 'beginPage'): the next screen is drawn in the blocks that are off the screen, then shown with the display shift
+
+HD44780Model controller;
+
+void setUp() {
+    mock_reset();
+    attach_test_controller(controller);
+}
+
+void tearDown() {}
+
+
+static void draw_page(LCD_Setup &lcd, const char *first_line, const char *second_line) {
+    lcd.beginPage();
+    lcd.moveCursor(1, 1);
+    lcd.display(first_line);
+    lcd.moveCursor(2, 1);
+    lcd.display(second_line);
+}
+
+
+void test_pages_appear_at_once() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.display("old screen");
+
+    draw_page(lcd, "page one", "line two");
+
+    // nothing changes on the screen until the flip
+    TEST_ASSERT_EQUAL_STRING("old screen      ", controller.line(1).c_str());
+
+    const unsigned long start_transactions{ controller.transactions };
+    const unsigned long start_time{ mock().clock };
+    lcd.flipPage();
+    report("page flip", controller.transactions - start_transactions, mock().clock - start_time);
+
+    TEST_ASSERT_EQUAL_STRING("page one        ", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL_STRING("line two        ", controller.line(2).c_str());
+
+    draw_page(lcd, "page two", "again");
+    TEST_ASSERT_EQUAL_STRING("page one        ", controller.line(1).c_str());
+
+    lcd.flipPage();
+    TEST_ASSERT_EQUAL_STRING("page two        ", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL_STRING("again           ", controller.line(2).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_blocks_count_from_the_shown_page_after_a_flip() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+
+    draw_page(lcd, "page one", "");
+    lcd.flipPage();
+
+    lcd.moveCursor(1, 10);
+    lcd.display("!");
+
+    TEST_ASSERT_EQUAL_STRING("page one !      ", controller.line(1).c_str());
+}
+
+
+void test_pages_with_a_framebuffer() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    LCD_Framebuffer framebuffer;
+    lcd.useFramebuffer(&framebuffer);
+
+    draw_page(lcd, "buffered", "page");
+    lcd.flipPage();
+
+    TEST_ASSERT_EQUAL_STRING("buffered        ", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL_STRING("page            ", controller.line(2).c_str());
+}
+
+
+void test_clear_display_goes_back_to_the_first_page() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+
+    draw_page(lcd, "page one", "");
+    lcd.flipPage();
+    lcd.clearDisplay();
+    lcd.display("hello");
+
+    TEST_ASSERT_EQUAL_STRING("hello           ", controller.line(1).c_str());
+}
+
+
+void test_clear_display_with_a_framebuffer() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    LCD_Framebuffer framebuffer;
+    lcd.useFramebuffer(&framebuffer);
+
+    draw_page(lcd, "page one", "line two");
+    lcd.flipPage();
+    lcd.clearDisplay();
+    lcd.display("hello");
+    lcd.flush();
+
+    TEST_ASSERT_EQUAL_STRING("hello           ", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL_STRING("                ", controller.line(2).c_str());
+}
+
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_pages_appear_at_once);
+    RUN_TEST(test_blocks_count_from_the_shown_page_after_a_flip);
+    RUN_TEST(test_pages_with_a_framebuffer);
+    RUN_TEST(test_clear_display_goes_back_to_the_first_page);
+    RUN_TEST(test_clear_display_with_a_framebuffer);
+    return UNITY_END();
+}
@@ -0,0 +1,134 @@
+#include <test_lcd.h>
+#include <arduino_lcdpp.h>
+
+// Transmit queue (see 'useTransmitQueue'): the sketch only waits when the queue is full, and 'service' sends each transaction once the LCD is ready
+
+HD44780Model controller;
+LCD_TransmitQueue queue;
+
+void setUp() {
+    mock_reset();
+    attach_test_controller(controller);
+}
+
+void tearDown() {}
+
+
+static unsigned long service_until_empty(LCD_Setup &lcd) {
+    unsigned long calls{ 0 };
+
+    while (!lcd.isQueueEmpty()) {
+        lcd.service();
+        calls++;
+    }
+
+    return calls;
+}
+
+
+void test_display_returns_without_waiting() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.useTransmitQueue(&queue);
+
+    const unsigned long start_transactions{ controller.transactions };
+    const unsigned long start_time{ mock().clock };
+    lcd.display("queued");
+
+    TEST_ASSERT_EQUAL(0, controller.transactions - start_transactions);
+    TEST_ASSERT_LESS_THAN(20, mock().clock - start_time);
+
+    service_until_empty(lcd);
+
+    TEST_ASSERT_EQUAL_STRING("queued          ", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+// 'service' is called at 1 kHz alongside the sketch's other work, like a timer interrupt would
+void test_service_keeps_the_execution_times() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.useTransmitQueue(&queue);
+
+    lcd.clearDisplay();
+    lcd.display("Temp: 21 C");
+    lcd.moveCursor(2, 1);
+    lcd.display("Humidity: 40 %");
+
+    const unsigned long start_transactions{ controller.transactions };
+    const unsigned long start_time{ mock().clock };
+
+    while (!lcd.isQueueEmpty()) {
+        lcd.service();
+        delayMicroseconds(1000);
+    }
+
+    report("queued refresh (1 kHz service)", controller.transactions - start_transactions, mock().clock - start_time);
+
+    TEST_ASSERT_EQUAL_STRING("Temp: 21 C      ", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL_STRING("Humidity: 40 %  ", controller.line(2).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_high_water_mark_and_overflow() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.useTransmitQueue(&queue);
+
+    lcd.display("0123456789");
+    TEST_ASSERT_EQUAL(10, queue.high_water_mark);
+    TEST_ASSERT_EQUAL(0, queue.overflow_count);
+
+    service_until_empty(lcd);
+
+    // the queue holds one transaction less than its size
+    lcd.moveCursor(1, 1);
+    lcd.display("0123456789012345678901234567890123456789");
+
+    TEST_ASSERT_EQUAL(LCD_transmit_queue_size - 1, queue.high_water_mark);
+    TEST_ASSERT_GREATER_THAN(0, queue.overflow_count);
+
+    service_until_empty(lcd);
+
+    TEST_ASSERT_EQUAL_STRING("0123456789012345678901234567890123456789", DDRAM_text(controller, 1, 40).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_queued_initialization() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.useTransmitQueue(&queue);
+
+    const unsigned long start_time{ mock().clock };
+    lcd.begin(LCD_power_is_stable);
+    TEST_ASSERT_LESS_THAN(100, mock().clock - start_time);
+
+    lcd.display("init");
+    service_until_empty(lcd);
+
+    TEST_ASSERT_EQUAL_STRING("init            ", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_detaching_finishes_the_queue() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.useTransmitQueue(&queue);
+
+    lcd.display("async");
+    lcd.useTransmitQueue(nullptr);
+    lcd.display(" sync");
+
+    TEST_ASSERT_EQUAL_STRING("async sync      ", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_display_returns_without_waiting);
+    RUN_TEST(test_service_keeps_the_execution_times);
+    RUN_TEST(test_high_water_mark_and_overflow);
+    RUN_TEST(test_queued_initialization);
+    RUN_TEST(test_detaching_finishes_the_queue);
+    return UNITY_END();
+}
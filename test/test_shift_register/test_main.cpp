@@ -0,0 +1,173 @@
+#include <test_lcd.h>
+#include <Wire.h>
+#include <arduino_lcdpp.h>
+
+// Shift register with rs & en on it too: a whole string goes to the buffered function in as few calls as the frame buffer allows
+
+#define TEST_RS_BIT 4
+#define TEST_EN_BIT 5
+
+HD44780Model controller;
+LCD_SRFrames frames;
+
+void setUp() {
+    mock_reset();
+    attach_SR_controller(controller);
+
+    // clocking a frame into a 74HC595 over SPI, plus the time it's held (LCD_SPI_frame_duration)
+    mock().shift_register.frame_time = 12;
+}
+
+void tearDown() {}
+
+
+static void wire_register(const bool isMSB) {
+    MockShiftRegister &shift_register{ mock().shift_register };
+
+    shift_register.isMSB = isMSB;
+    shift_register.rs_bit = isMSB ? TEST_RS_BIT : TEST_RS_BIT - 4;
+    shift_register.en_bit = isMSB ? TEST_EN_BIT : TEST_EN_BIT - 4;
+}
+
+
+static void check_refresh(const bool isMSB) {
+    wire_register(isMSB);
+    LCD_Setup lcd(true, false, mock_SR_send_buffer, &frames, mock().shift_register.rs_bit, mock().shift_register.en_bit, isMSB);
+
+    const unsigned long start_calls{ mock().shift_register.calls };
+    const unsigned long start_frames{ mock().shift_register.frames };
+    const unsigned long start_transactions{ controller.transactions };
+    const unsigned long start_time{ mock().clock };
+
+    lcd.display("0123456789ABCDEF");
+    lcd.moveCursor(2, 1);
+    lcd.display("FEDCBA9876543210");
+
+    char scenario[80];
+    snprintf(scenario, sizeof(scenario), "32 characters, %s (%lu SR calls, %lu frames)", isMSB ? "MSB" : "LSB", mock().shift_register.calls - start_calls, mock().shift_register.frames - start_frames);
+    report(scenario, controller.transactions - start_transactions, mock().clock - start_time);
+
+    TEST_ASSERT_EQUAL_STRING("0123456789ABCDEF", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL_STRING("FEDCBA9876543210", controller.line(2).c_str());
+
+    // 2 strings that don't fit in one buffer, and the cursor move
+    TEST_ASSERT_LESS_OR_EQUAL(5, mock().shift_register.calls - start_calls);
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_refresh_MSB() {
+    check_refresh(true);
+}
+
+
+void test_refresh_LSB() {
+    check_refresh(false);
+}
+
+
+// the 2nd constructor sends every nibble on its own, as a baseline
+void test_refresh_data_pins_only() {
+    controller.useEightBitPins(TEST_RS_PIN, TEST_RW_PIN, TEST_EN_PIN, TEST_SR_DB7_PIN, TEST_SR_DB7_PIN - 1, TEST_SR_DB7_PIN - 2, TEST_SR_DB7_PIN - 3, TEST_SR_DB7_PIN - 4, TEST_SR_DB7_PIN - 5, TEST_SR_DB7_PIN - 6, TEST_SR_DB7_PIN - 7);
+
+    LCD_Setup lcd(TEST_RS_PIN, TEST_RW_PIN, TEST_EN_PIN, 4, true, false, mock_SR_write);
+
+    const unsigned long start_calls{ mock().shift_register.calls };
+    const unsigned long start_transactions{ controller.transactions };
+    const unsigned long start_time{ mock().clock };
+
+    lcd.display("0123456789ABCDEF");
+    lcd.moveCursor(2, 1);
+    lcd.display("FEDCBA9876543210");
+
+    char scenario[80];
+    snprintf(scenario, sizeof(scenario), "32 characters, data pins only (%lu SR calls)", mock().shift_register.calls - start_calls);
+    report(scenario, controller.transactions - start_transactions, mock().clock - start_time);
+
+    TEST_ASSERT_EQUAL_STRING("FEDCBA9876543210", controller.line(2).c_str());
+    TEST_ASSERT_EQUAL(66, mock().shift_register.calls - start_calls);
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_custom_characters_through_the_register() {
+    wire_register(true);
+    LCD_Setup lcd(true, false, mock_SR_send_buffer, &frames, TEST_RS_BIT, TEST_EN_BIT, true);
+
+    const byte smiley[8]{ B00000, B01010, B01010, B00000, B10001, B01110, B00000, B00000 };
+    lcd.createCustomCharacter(2, smiley);
+    lcd.displayCustomCharacter(2);
+
+    TEST_ASSERT_EQUAL_MEMORY(smiley, &controller.cgram[16], 8);
+    TEST_ASSERT_EQUAL(2, controller.ddram[0]);
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+// the frames of a batch only space the bytes out by the time the register takes to clock them, which a slow profile needs more than
+void test_slow_profile_through_the_register() {
+    static const LCD_TimingProfile slow_controller{ 120, 100, 3000, 6000, 300, 60000 };
+
+    wire_register(true);
+    LCD_Setup lcd(true, false, mock_SR_send_buffer, &frames, TEST_RS_BIT, TEST_EN_BIT, true);
+    lcd.useTimingProfile(&slow_controller);
+
+    controller.data_write_time = slow_controller.data_write;
+    controller.command_time = slow_controller.command;
+
+    lcd.display("0123456789ABCDEF");
+
+    TEST_ASSERT_EQUAL_STRING("0123456789ABCDEF", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+HD44780Model backpack_controller;
+LCD_Setup *queued_lcd;
+
+static void service_from_interrupt() {
+    queued_lcd->service();
+}
+
+
+// an interrupt servicing another LCD while a long string is being sent mustn't send that string's frames through the other LCD's function
+void test_frames_belong_to_their_LCD() {
+    wire_register(true);
+    LCD_Setup lcd(true, false, mock_SR_send_buffer, &frames, TEST_RS_BIT, TEST_EN_BIT, true);
+
+    backpack_controller = HD44780Model();
+    backpack_controller.useEightBitPins(TEST_SR_RS_PIN + 50, TEST_SR_RW_PIN + 50, TEST_SR_EN_PIN + 50, TEST_SR_DB7_PIN + 50, TEST_SR_DB7_PIN + 49, TEST_SR_DB7_PIN + 48, TEST_SR_DB7_PIN + 47, -1, -1, -1, -1);
+    mock_attach(&backpack_controller);
+    Wire = TwoWire();
+    Wire.backpack = &backpack_controller;
+
+    LCD_SRFrames backpack_frames;
+    LCD_TransmitQueue queue;
+    LCD_Setup backpack_lcd(0x27, true, false, LCD_I2C_send, &backpack_frames);
+    backpack_lcd.begin();
+    backpack_lcd.useTransmitQueue(&queue);
+
+    queued_lcd = &backpack_lcd;
+    mock().interrupt_handler = service_from_interrupt;
+
+    backpack_lcd.display("backpack");
+    lcd.display("0123456789ABCDEFGHIJ0123456789ABCDEFGHIJ");
+
+    while (!backpack_lcd.isQueueEmpty()) { backpack_lcd.service(); }
+    mock().interrupt_handler = nullptr;
+
+    TEST_ASSERT_EQUAL_STRING("0123456789ABCDEFGHIJ0123456789ABCDEFGHIJ", DDRAM_text(controller, 1, 40).c_str());
+    TEST_ASSERT_EQUAL_STRING("backpack        ", backpack_controller.line(1).c_str());
+}
+
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_refresh_MSB);
+    RUN_TEST(test_refresh_LSB);
+    RUN_TEST(test_refresh_data_pins_only);
+    RUN_TEST(test_custom_characters_through_the_register);
+    RUN_TEST(test_slow_profile_through_the_register);
+    RUN_TEST(test_frames_belong_to_their_LCD);
+    return UNITY_END();
+}
@@ -0,0 +1,106 @@
+#include <test_lcd.h>
+#include <arduino_lcdpp.h>
+
+// Stats counters (built with LCD_collect_stats, see 'getStats')
+
+HD44780Model controller;
+LCD_TransmitQueue queue;
+LCD_SRFrames frames;
+
+void setUp() {
+    mock_reset();
+    attach_test_controller(controller);
+}
+
+void tearDown() {}
+
+
+void test_counters_match_the_controller() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.resetStats();
+
+    const unsigned long start_gpio_writes{ mock().gpio_writes };
+    const unsigned long start_time{ mock().clock };
+
+    lcd.clearDisplay();
+    lcd.display("stats");
+    lcd.moveCursor(2, 3);
+    lcd.display(42);
+
+    const LCD_Stats stats{ lcd.getStats() };
+
+    TEST_ASSERT_EQUAL(7, stats.data_bytes);
+    TEST_ASSERT_EQUAL(1, stats.command_bytes[0]);
+    TEST_ASSERT_EQUAL(1, stats.command_bytes[7]);
+    TEST_ASSERT_EQUAL(controller.data_writes, controller.transactions - controller.command_writes);
+    TEST_ASSERT_EQUAL(mock().gpio_writes - start_gpio_writes, stats.GPIO_writes);
+    TEST_ASSERT_LESS_OR_EQUAL(mock().clock - start_time, stats.blocked_microseconds);
+    TEST_ASSERT_GREATER_OR_EQUAL(LCD_HD44780_timing.clear_and_home, stats.max_clearDisplay_latency);
+    TEST_ASSERT_GREATER_THAN(0, stats.max_display_latency);
+    TEST_ASSERT_GREATER_THAN(0, stats.max_moveCursor_latency);
+}
+
+
+void test_reset_stats() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.display("x");
+    lcd.resetStats();
+
+    const LCD_Stats stats{ lcd.getStats() };
+
+    TEST_ASSERT_EQUAL(0, stats.data_bytes);
+    TEST_ASSERT_EQUAL(0, stats.GPIO_writes);
+    TEST_ASSERT_EQUAL(0, stats.max_display_latency);
+}
+
+
+// the sketch is blocked while it waits for room in a full queue, however much of that time 'service' spends sending
+void test_full_queue_wait_is_blocked_time() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.useTransmitQueue(&queue);
+    lcd.resetStats();
+
+    const unsigned long start_time{ mock().clock };
+    lcd.display("0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF");
+    const unsigned long elapsed_time{ mock().clock - start_time };
+
+    const LCD_Stats stats{ lcd.getStats() };
+
+    TEST_ASSERT_GREATER_THAN(0, queue.overflow_count);
+    TEST_ASSERT_LESS_OR_EQUAL(elapsed_time, stats.blocked_microseconds);
+    TEST_ASSERT_GREATER_OR_EQUAL(elapsed_time - 100, stats.blocked_microseconds);
+
+    lcd.useTransmitQueue(nullptr);
+}
+
+
+// the shift register function takes its time clocking the frames out, which the sketch waits for too
+void test_shift_register_calls_are_blocked_time() {
+    attach_SR_controller(controller);
+    mock().shift_register.rs_bit = 4;
+    mock().shift_register.en_bit = 5;
+    mock().shift_register.frame_time = 12;
+
+    LCD_Setup lcd(true, false, mock_SR_send_buffer, &frames, 4, 5, true);
+    lcd.resetStats();
+
+    const unsigned long start_frames{ mock().shift_register.frames };
+    const unsigned long start_time{ mock().clock };
+    lcd.display("0123456789ABCDEF");
+    const unsigned long elapsed_time{ mock().clock - start_time };
+
+    const LCD_Stats stats{ lcd.getStats() };
+
+    TEST_ASSERT_GREATER_OR_EQUAL((mock().shift_register.frames - start_frames) * 12, stats.blocked_microseconds);
+    TEST_ASSERT_LESS_OR_EQUAL(elapsed_time, stats.blocked_microseconds);
+}
+
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_counters_match_the_controller);
+    RUN_TEST(test_reset_stats);
+    RUN_TEST(test_full_queue_wait_is_blocked_time);
+    RUN_TEST(test_shift_register_calls_are_blocked_time);
+    return UNITY_END();
+}
@@ -0,0 +1,103 @@
+#include <test_lcd.h>
+#include <arduino_lcdpp.h>
+
+// Print support, bulk writes and the visible columns (see 'write' & 'setVisibleColumns')
+
+HD44780Model controller;
+
+void setUp() {
+    mock_reset();
+    attach_test_controller(controller);
+}
+
+void tearDown() {}
+
+
+void test_print_and_println() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    Print &printer{ lcd };
+
+    printer.print("T=");
+    printer.print(21);
+    printer.print(' ');
+    printer.print(-3L);
+
+    TEST_ASSERT_EQUAL_STRING("T=21 -3         ", controller.line(1).c_str());
+}
+
+
+void test_write_returns_the_length() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+
+    TEST_ASSERT_EQUAL(5, lcd.write("hello"));
+    TEST_ASSERT_EQUAL(3, lcd.write("abcdef", 3));
+    TEST_ASSERT_EQUAL(1, lcd.write((uint8_t)'!'));
+    TEST_ASSERT_EQUAL(4, lcd.write(String("text")));
+    TEST_ASSERT_EQUAL(5, lcd.write(F("flash")));
+
+    TEST_ASSERT_EQUAL_STRING("helloabc!textfla", controller.line(1).c_str());
+}
+
+
+void test_display_takes_every_string_type() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+
+    const String text("str");
+    lcd.display(text, F(" flash"), ' ', 'c');
+
+    TEST_ASSERT_EQUAL_STRING("str flash c     ", controller.line(1).c_str());
+}
+
+
+void test_visible_columns_wrap() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.setVisibleColumns(16);
+
+    lcd.display("This is too long for one line");
+
+    TEST_ASSERT_EQUAL_STRING("This is too long", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL_STRING(" for one line   ", controller.line(2).c_str());
+    TEST_ASSERT_EQUAL_STRING(std::string(24, ' ').c_str(), DDRAM_text(controller, 1, 40).substr(16).c_str());
+}
+
+
+void test_visible_columns_drop() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.setVisibleColumns(16, false);
+
+    lcd.display("This is too long for one line");
+
+    TEST_ASSERT_EQUAL_STRING("This is too long", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL_STRING("                ", controller.line(2).c_str());
+    TEST_ASSERT_EQUAL(16, controller.data_writes);
+
+    // only the characters that made it onto the line are counted
+    lcd.moveCursor(2, 1);
+    TEST_ASSERT_EQUAL(16, lcd.write("This is too long for one line"));
+    TEST_ASSERT_EQUAL(0, lcd.write((uint8_t)'!'));
+    TEST_ASSERT_EQUAL(0, lcd.write(F("flash")));
+}
+
+
+void test_bulk_write_benchmark() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+
+    const unsigned long start_transactions{ controller.transactions };
+    const unsigned long start_time{ mock().clock };
+    lcd.write("0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF", 80);
+
+    report("80 characters in one write", controller.transactions - start_transactions, mock().clock - start_time);
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_print_and_println);
+    RUN_TEST(test_write_returns_the_length);
+    RUN_TEST(test_display_takes_every_string_type);
+    RUN_TEST(test_visible_columns_wrap);
+    RUN_TEST(test_visible_columns_drop);
+    RUN_TEST(test_bulk_write_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,104 @@
+#include <test_lcd.h>
+#include <arduino_lcdpp.h>
+
+// Tickers (see 'startTicker'): with the display shift each step only writes the character that comes into view
+
+HD44780Model controller;
+LCD_Ticker ticker;
+
+const char news[]{ "Breaking news: the LCD scrolls.   " };
+
+void setUp() {
+    mock_reset();
+    attach_test_controller(controller);
+}
+
+void tearDown() {}
+
+
+static std::string expected_view(const size_t first_character) {
+    std::string view;
+    for (size_t i{ 0 }; i < 16; i++) { view += news[(first_character + i) % (sizeof(news) - 1)]; }
+
+    return view;
+}
+
+
+void test_scrolling_with_the_display_shift() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.startTicker(&ticker, 1, news);
+
+    TEST_ASSERT_EQUAL_STRING(expected_view(0).c_str(), controller.line(1).c_str());
+
+    const unsigned long start_transactions{ controller.transactions };
+    const unsigned long start_time{ mock().clock };
+
+    for (size_t step{ 1 }; step <= 100; step++) {
+        lcd.scrollTicker(&ticker);
+        TEST_ASSERT_EQUAL_STRING(expected_view(step).c_str(), controller.line(1).c_str());
+    }
+
+    report("100 ticker steps with the display shift", controller.transactions - start_transactions, mock().clock - start_time);
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_scrolling_one_line() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.moveCursor(2, 1);
+    lcd.display("stays still");
+    lcd.startTicker(&ticker, 1, news, false);
+
+    for (size_t step{ 1 }; step <= 50; step++) {
+        lcd.scrollTicker(&ticker);
+        TEST_ASSERT_EQUAL_STRING(expected_view(step).c_str(), controller.line(1).c_str());
+    }
+
+    TEST_ASSERT_EQUAL_STRING("stays still     ", controller.line(2).c_str());
+}
+
+
+void test_scrolling_one_line_with_a_framebuffer() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    LCD_Framebuffer framebuffer;
+    lcd.useFramebuffer(&framebuffer);
+
+    lcd.startTicker(&ticker, 1, news, false);
+    lcd.flush();
+
+    const unsigned long start_transactions{ controller.transactions };
+    const unsigned long start_time{ mock().clock };
+
+    for (size_t step{ 1 }; step <= 100; step++) {
+        lcd.scrollTicker(&ticker);
+        lcd.flush();
+        TEST_ASSERT_EQUAL_STRING(expected_view(step).c_str(), controller.line(1).c_str());
+    }
+
+    report("100 ticker steps with a framebuffer", controller.transactions - start_transactions, mock().clock - start_time);
+}
+
+
+void test_scrolling_with_the_display_shift_and_a_framebuffer() {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    LCD_Framebuffer framebuffer;
+    lcd.useFramebuffer(&framebuffer);
+
+    lcd.startTicker(&ticker, 1, news);
+    lcd.flush();
+
+    for (size_t step{ 1 }; step <= 50; step++) {
+        lcd.scrollTicker(&ticker);
+        TEST_ASSERT_EQUAL_STRING(expected_view(step).c_str(), controller.line(1).c_str());
+    }
+}
+
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_scrolling_with_the_display_shift);
+    RUN_TEST(test_scrolling_one_line);
+    RUN_TEST(test_scrolling_one_line_with_a_framebuffer);
+    RUN_TEST(test_scrolling_with_the_display_shift_and_a_framebuffer);
+    return UNITY_END();
+}
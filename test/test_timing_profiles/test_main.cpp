@@ -0,0 +1,102 @@
+#include <test_lcd.h>
+#include <arduino_lcdpp.h>
+
+// Timing profiles (see 'useTimingProfile'): every wait comes from the profile, so a controller that matches it is never written to while busy
+
+HD44780Model controller;
+
+void setUp() {
+    mock_reset();
+    attach_test_controller(controller);
+}
+
+void tearDown() {}
+
+
+// sets the simulated controller to take exactly as long as the profile says
+static void match_controller(const LCD_TimingProfile &profile) {
+    controller.data_write_time = profile.data_write;
+    controller.command_time = profile.command;
+    controller.clear_and_home_time = profile.clear_and_home;
+    controller.first_function_set_time = profile.first_function_set;
+    controller.second_function_set_time = profile.second_function_set;
+    controller.power_rise_time = profile.power_rise;
+}
+
+
+static void check_profile(const char *name, const LCD_TimingProfile &profile) {
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+
+    // the LCD is switched on after the board, so the whole initialization runs on the profile's times
+    attach_test_controller(controller);
+    match_controller(profile);
+
+    lcd.useTimingProfile(&profile);
+    lcd.begin(LCD_wait_for_power_rise);
+
+    const unsigned long start_transactions{ controller.transactions };
+    const unsigned long start_time{ mock().clock };
+
+    lcd.clearDisplay();
+    lcd.display("0123456789ABCDEF");
+    lcd.moveCursor(2, 1);
+    lcd.display("FEDCBA9876543210");
+
+    char scenario[80];
+    snprintf(scenario, sizeof(scenario), "full 16x2 refresh, %s", name);
+    report(scenario, controller.transactions - start_transactions, mock().clock - start_time);
+
+    TEST_ASSERT_EQUAL_STRING("0123456789ABCDEF", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL_STRING("FEDCBA9876543210", controller.line(2).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_HD44780_profile() {
+    check_profile("HD44780", LCD_HD44780_timing);
+}
+
+
+void test_ST7066U_profile() {
+    check_profile("ST7066U", LCD_ST7066U_timing);
+}
+
+
+void test_KS0066_profile() {
+    check_profile("KS0066", LCD_KS0066_timing);
+}
+
+
+void test_fast_OLED_profile() {
+    check_profile("fast OLED", LCD_fast_OLED_timing);
+}
+
+
+void test_custom_profile() {
+    static const LCD_TimingProfile slow_controller{ 120, 100, 3000, 6000, 300, 60000 };
+    check_profile("custom", slow_controller);
+}
+
+
+// a profile that's too fast for the controller shows up as violations
+void test_too_fast_profile_is_caught() {
+    controller.data_write_time = 100;
+
+    LCD_Setup lcd(TEST_4_BIT_LCD);
+    lcd.useTimingProfile(&LCD_fast_OLED_timing);
+    lcd.display("ab");
+
+    TEST_ASSERT_GREATER_THAN(0, mock_violations());
+}
+
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_HD44780_profile);
+    RUN_TEST(test_ST7066U_profile);
+    RUN_TEST(test_KS0066_profile);
+    RUN_TEST(test_fast_OLED_profile);
+    RUN_TEST(test_custom_profile);
+    RUN_TEST(test_too_fast_profile_is_caught);
+    return UNITY_END();
+}
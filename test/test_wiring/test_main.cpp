@@ -0,0 +1,118 @@
+#include <test_lcd.h>
+#include <arduino_lcdpp.h>
+
+// Every way of wiring the LCD has to put the same characters on the screen (the encoders are picked once per wiring, see 'select_encoder')
+
+HD44780Model controller;
+
+void setUp() {
+    mock_reset();
+}
+
+void tearDown() {}
+
+
+static void check_hello(LCD_Setup &lcd) {
+    lcd.display("Hello");
+    lcd.moveCursor(2, 3);
+    lcd.display("World ", 42);
+
+    TEST_ASSERT_EQUAL_STRING("Hello           ", controller.line(1).c_str());
+    TEST_ASSERT_EQUAL_STRING("  World 42      ", controller.line(2).c_str());
+    TEST_ASSERT_EQUAL(0, mock_violations());
+}
+
+
+void test_direct_4_bit() {
+    attach_test_controller(controller);
+    LCD_Setup lcd(TEST_RS_PIN, TEST_RW_PIN, TEST_EN_PIN, 4, true, false, TEST_DB7_PIN, TEST_DB6_PIN, TEST_DB5_PIN, TEST_DB4_PIN);
+
+    TEST_ASSERT_FALSE(controller.isEightBitMode);
+    check_hello(lcd);
+}
+
+
+void test_direct_8_bit() {
+    attach_test_controller(controller, true);
+    LCD_Setup lcd(TEST_RS_PIN, TEST_RW_PIN, TEST_EN_PIN, 8, true, false, TEST_DB7_PIN, TEST_DB6_PIN, TEST_DB5_PIN, TEST_DB4_PIN, TEST_DB3_PIN, TEST_DB2_PIN, TEST_DB1_PIN, TEST_DB0_PIN);
+
+    TEST_ASSERT_TRUE(controller.isEightBitMode);
+    check_hello(lcd);
+}
+
+
+// the data pins are on the register, rs, rw & en on the Arduino
+static void wire_shift_register(const uint8_t data_length, const bool isMSB) {
+    controller = HD44780Model();
+    controller.useEightBitPins(TEST_RS_PIN, TEST_RW_PIN, TEST_EN_PIN, TEST_SR_DB7_PIN, TEST_SR_DB7_PIN - 1, TEST_SR_DB7_PIN - 2, TEST_SR_DB7_PIN - 3, TEST_SR_DB7_PIN - 4, TEST_SR_DB7_PIN - 5, TEST_SR_DB7_PIN - 6, TEST_SR_DB7_PIN - 7);
+    mock_attach(&controller);
+
+    mock().shift_register.controller = &controller;
+    mock().shift_register.isMSB = isMSB;
+    mock().shift_register.isEightBit = data_length == 8;
+}
+
+
+static void check_shift_register(const uint8_t data_length, const bool isMSB) {
+    wire_shift_register(data_length, isMSB);
+    LCD_Setup lcd(TEST_RS_PIN, TEST_RW_PIN, TEST_EN_PIN, data_length, true, false, mock_SR_write, isMSB);
+
+    TEST_ASSERT_EQUAL(data_length == 8, controller.isEightBitMode);
+    check_hello(lcd);
+}
+
+
+void test_shift_register_4_bit_MSB() {
+    check_shift_register(4, true);
+}
+
+
+void test_shift_register_4_bit_LSB() {
+    check_shift_register(4, false);
+}
+
+
+void test_shift_register_8_bit_MSB() {
+    check_shift_register(8, true);
+}
+
+
+void test_shift_register_8_bit_LSB() {
+    check_shift_register(8, false);
+}
+
+
+
+// the bit order of each byte comes from one table, so every character code is checked with both registers
+static void check_every_character_code(const uint8_t data_length, const bool isMSB) {
+    wire_shift_register(data_length, isMSB);
+    LCD_Setup lcd(TEST_RS_PIN, TEST_RW_PIN, TEST_EN_PIN, data_length, true, false, mock_SR_write, isMSB);
+
+    for (int code{ 0 }; code < 256; code++) {
+        lcd.moveCursor(1, 1);
+        lcd.display((char)code);
+
+        TEST_ASSERT_EQUAL(code, controller.ddram[0]);
+    }
+}
+
+
+void test_every_character_code() {
+    check_every_character_code(4, true);
+    check_every_character_code(4, false);
+    check_every_character_code(8, true);
+    check_every_character_code(8, false);
+}
+
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_direct_4_bit);
+    RUN_TEST(test_direct_8_bit);
+    RUN_TEST(test_shift_register_4_bit_MSB);
+    RUN_TEST(test_shift_register_4_bit_LSB);
+    RUN_TEST(test_shift_register_8_bit_MSB);
+    RUN_TEST(test_shift_register_8_bit_LSB);
+    RUN_TEST(test_every_character_code);
+    return UNITY_END();
+}